@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/BaseN.h>
+#include "Benchmark.h"
+
+// encode the payload, throughput relates to the decoded size
+template<typename Coder>
+static void encodeBench(BenchmarkState &state) {
+    Buffer in(BenchmarkRunner::payload(state.size()), state.size());
+
+    while (state.keepRunning()) {
+        String out = Coder::encode(in);
+        doNotOptimize(out.const_data());
+    }
+}
+
+// decode the encoded payload, throughput relates to the decoded size
+template<typename Coder>
+static void decodeBench(BenchmarkState &state) {
+    String in = Coder::encode(Buffer(BenchmarkRunner::payload(state.size()), state.size()));
+
+    while (state.keepRunning()) {
+        Buffer out = Coder::decode(in);
+        doNotOptimize(out.const_data());
+    }
+}
+
+// encode and decode a std::string, processed in place without copying it into a Buffer first
+template<typename Coder>
+static void stringBench(BenchmarkState &state) {
+    std::string in(reinterpret_cast<const char *>(BenchmarkRunner::payload(state.size())), state.size());
+
+    while (state.keepRunning()) {
+        std::string out = Coder::decodeString(Coder::encodeString(in));
+        doNotOptimize(out.data());
+    }
+}
+
+BENCHMARK(Hex, encode) { encodeBench<Hex>(state); }
+BENCHMARK(Hex, decode) { decodeBench<Hex>(state); }
+BENCHMARK(Base16, encode) { encodeBench<Base16>(state); }
+BENCHMARK(Base16, decode) { decodeBench<Base16>(state); }
+BENCHMARK(Base32, encode) { encodeBench<Base32>(state); }
+BENCHMARK(Base32, decode) { decodeBench<Base32>(state); }
+BENCHMARK(Base64, encode) { encodeBench<Base64>(state); }
+BENCHMARK(Base64, decode) { decodeBench<Base64>(state); }
+BENCHMARK(Base64, string) { stringBench<Base64>(state); }
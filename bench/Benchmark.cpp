@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <secure_memory/SecureHeap.h>
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SplitMix64.h>
+#include "Benchmark.h"
+
+/* ALLOCATION COUNTING */
+
+static std::atomic<uint64_t> sAllocations {0};
+
+void *operator new(size_t size) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+// aligned variants, e.g. of SecurePool's resource for over-aligned blocks
+void *operator new(size_t size, std::align_val_t alignment) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    // aligned_alloc requires a multiple of the alignment
+    auto align = static_cast<size_t>(alignment);
+    size = (std::max<size_t>(size, 1) + align - 1) / align * align;
+    if (void *p = std::aligned_alloc(align, size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    try {
+        return operator new(size, alignment);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &tag) noexcept {
+    return operator new(size, alignment, tag);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+/* STATE */
+
+void BenchmarkState::pauseTiming() {
+    mPauseStart = Clock::now();
+    mAllocPauseStart = BenchmarkRunner::allocations();
+}
+
+void BenchmarkState::resumeTiming() {
+    mPaused += Clock::now() - mPauseStart;
+    mAllocPaused += BenchmarkRunner::allocations() - mAllocPauseStart;
+}
+
+bool BenchmarkState::check() {
+    auto now = Clock::now();
+
+    // first call: start measuring
+    if (mNextCheck == 0) {
+        mAllocStart = BenchmarkRunner::allocations();
+        mStart = Clock::now();
+        mNextCheck = 1;
+        return true;
+    }
+
+    // stop once minimum time has elapsed, otherwise check again after twice the iterations
+    if (std::chrono::duration<double>(now - mStart - mPaused).count() >= BenchmarkRunner::sMinTime) {
+        mEnd = now;
+        mAllocEnd = BenchmarkRunner::allocations();
+        // the last call did not perform an operation
+        mIterations--;
+        return false;
+    }
+
+    mNextCheck = mIterations * 2;
+    return true;
+}
+
+/* RUNNER */
+
+double BenchmarkRunner::sMinTime = 0.2;
+
+std::vector<BenchmarkRunner::Entry> &BenchmarkRunner::registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+bool BenchmarkRunner::add(std::string name, Function fn) {
+    registry().push_back({std::move(name), std::move(fn)});
+    return true;
+}
+
+uint64_t BenchmarkRunner::allocations() {
+    // the library's page and locked allocators do not go through operator new
+    return sAllocations.load(std::memory_order_relaxed) + SecurePages::allocations() +
+           SecureHeap::stats().allocations;
+}
+
+const std::vector<size_t> &BenchmarkRunner::sizes() {
+    static const std::vector<size_t> sizes {
+        16, 256, 4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024
+    };
+    return sizes;
+}
+
+const uint8_t *BenchmarkRunner::payload(size_t size) {
+    static std::vector<uint8_t> data;
+
+    if (data.size() < size) {
+        data.resize(size);
+        SplitMix64 rng(0x5ec0de);
+        for (auto &b : data)
+            b = static_cast<uint8_t>(rng.next());
+    }
+    return data.data();
+}
+
+static const char *formatSize(size_t size, char *buf, size_t len) {
+    if (size >= 1024 * 1024)
+        snprintf(buf, len, "%zu MiB", size / (1024 * 1024));
+    else if (size >= 1024)
+        snprintf(buf, len, "%zu KiB", size / 1024);
+    else
+        snprintf(buf, len, "%zu B", size);
+    return buf;
+}
+
+void BenchmarkRunner::run(const std::string &filter, size_t maxSize, double minTime) {
+    sMinTime = minTime;
+
+    printf("%-36s %10s %12s %14s %12s %12s\n", "benchmark", "size", "iterations", "ns/op", "MiB/s", "allocs/op");
+    for (auto &entry : registry()) {
+        if (entry.name.find(filter) == std::string::npos)
+            continue;
+
+        for (size_t size : sizes()) {
+            if (size > maxSize)
+                break;
+
+            BenchmarkState state(size);
+            entry.fn(state);
+
+            uint64_t iterations = state.mIterations > 0 ? state.mIterations : 1;
+            double ns = std::chrono::duration<double, std::nano>(state.mEnd - state.mStart - state.mPaused).count();
+            double nsPerOp = ns / iterations;
+            size_t bytes = state.mBytesPerOp != 0 ? state.mBytesPerOp : size;
+            double mibPerSec = (double(bytes) * iterations / (1024.0 * 1024.0)) / (ns / 1e9);
+            double allocsPerOp = double(state.mAllocEnd - state.mAllocStart - state.mAllocPaused) / iterations;
+
+            char sizeBuf[32];
+            printf("%-36s %10s %12llu %14.1f %12.1f %12.2f\n", entry.name.c_str(),
+                   formatSize(size, sizeBuf, sizeof(sizeBuf)), static_cast<unsigned long long>(iterations),
+                   nsPerOp, mibPerSec, allocsPerOp);
+            fflush(stdout);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string filter;
+    size_t maxSize = BenchmarkRunner::sizes().back();
+    double minTime = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--filter=", 9) == 0)
+            filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--max-size=", 11) == 0)
+            maxSize = strtoull(argv[i] + 11, nullptr, 10);
+        else if (strncmp(argv[i], "--min-time=", 11) == 0)
+            minTime = strtod(argv[i] + 11, nullptr);
+        else {
+            fprintf(stderr, "usage: %s [--filter=<substring>] [--max-size=<bytes>] [--min-time=<seconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    BenchmarkRunner::run(filter, maxSize, minTime);
+    return 0;
+}
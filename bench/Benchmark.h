@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_BENCHMARK_H
+#define SECUREMEMORY_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Loop state of a single benchmark run at a fixed payload size. Benchmarks loop on keepRunning() and perform exactly
+ * one operation per iteration.
+ */
+class BenchmarkState {
+public:
+    explicit BenchmarkState(size_t size) : mSize(size) { }
+
+    /**
+     * @return True while the benchmark should perform another operation
+     */
+    inline bool keepRunning() {
+        if (mIterations++ < mNextCheck)
+            return true;
+        return check();
+    }
+
+    /**
+     * @return Payload size in bytes of this run
+     */
+    inline size_t size() const {
+        return mSize;
+    }
+
+    /**
+     * Overrides the number of bytes processed by a single operation. Defaults to size().
+     *
+     * @param bytes Bytes processed per operation
+     */
+    inline void bytesPerOp(size_t bytes) {
+        mBytesPerOp = bytes;
+    }
+
+    /**
+     * Excludes the time spent in setup code from the measurement. Must be paired with resumeTiming().
+     */
+    void pauseTiming();
+    /**
+     * Resumes the time measurement after pauseTiming().
+     */
+    void resumeTiming();
+
+private:
+    friend class BenchmarkRunner;
+
+    bool check();
+
+    using Clock = std::chrono::steady_clock;
+
+    // payload size of this run
+    size_t mSize;
+    // bytes processed per operation, 0 if size() is used
+    size_t mBytesPerOp = 0;
+    // operations performed (plus one during the loop)
+    uint64_t mIterations = 0;
+    // iteration count at which the clock is consulted next
+    uint64_t mNextCheck = 0;
+    // time spent in paused sections
+    Clock::duration mPaused {};
+    Clock::time_point mStart, mPauseStart, mEnd;
+    // allocation counter values at start and end
+    uint64_t mAllocStart = 0, mAllocEnd = 0, mAllocPaused = 0, mAllocPauseStart = 0;
+};
+
+/**
+ * Registry and runner of all benchmarks.
+ */
+class BenchmarkRunner {
+public:
+    using Function = std::function<void(BenchmarkState &)>;
+
+    /**
+     * Registers a benchmark. Used by the BENCHMARK macro.
+     *
+     * @param name Full benchmark name
+     * @param fn Benchmark function
+     * @return Always true
+     */
+    static bool add(std::string name, Function fn);
+
+    /**
+     * Runs all benchmarks whose name contains filter for every payload size up to maxSize.
+     */
+    static void run(const std::string &filter, size_t maxSize, double minTime);
+
+    /**
+     * @return Number of heap allocations performed since program start, including blocks of SecurePages and
+     * SecureHeap
+     */
+    static uint64_t allocations();
+
+    /**
+     * @param size Number of bytes required
+     * @return Pointer to at least size bytes of deterministic pseudo random data
+     */
+    static const uint8_t *payload(size_t size);
+
+    /**
+     * Payload sizes every benchmark is run with: 16 B to 64 MiB
+     */
+    static const std::vector<size_t> &sizes();
+
+private:
+    friend class BenchmarkState;
+
+    struct Entry {
+        std::string name;
+        Function fn;
+    };
+    static std::vector<Entry> &registry();
+
+    static double sMinTime;
+};
+
+/**
+ * Prevents the compiler from optimizing away the computation of value.
+ */
+template<typename T>
+inline void doNotOptimize(const T &value) {
+    __asm__ __volatile__(""::"r,m"(value): "memory");
+}
+
+/**
+ * Prevents the compiler from optimizing away memory operations preceding this call.
+ */
+inline void clobberMemory() {
+    __asm__ __volatile__("":::"memory");
+}
+
+#define SM_BENCHMARK_CONCAT_(a, b) a##b
+#define SM_BENCHMARK_CONCAT(a, b) SM_BENCHMARK_CONCAT_(a, b)
+
+/**
+ * Defines and registers a benchmark named group/name. The body receives a BenchmarkState &state.
+ */
+#define BENCHMARK(group, name)                                                                              \
+    static void SM_BENCHMARK_CONCAT(bench_##group##_, name)(BenchmarkState &state);                         \
+    static const bool SM_BENCHMARK_CONCAT(bench_reg_##group##_, name) =                                     \
+            BenchmarkRunner::add(#group "/" #name, SM_BENCHMARK_CONCAT(bench_##group##_, name));            \
+    static void SM_BENCHMARK_CONCAT(bench_##group##_, name)(BenchmarkState &state)
+
+#endif //SECUREMEMORY_BENCHMARK_H
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+#include <secure_memory/Buffer.h>
+#include "Benchmark.h"
+
+// size of the chunks used by chunked and streaming benchmarks
+static constexpr uint32_t CHUNK_SIZE = 4096;
+
+// construct a default Buffer and append the whole payload at once
+BENCHMARK(Buffer, append) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+
+    while (state.keepRunning()) {
+        Buffer b;
+        b.append(payload, state.size());
+        doNotOptimize(b.const_data());
+    }
+}
+
+// construct a default Buffer and append the payload in small chunks, growing it repeatedly
+static void appendChunked(BenchmarkState &state, BufferGrowth growth) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(16, state.size());
+
+    while (state.keepRunning()) {
+        Buffer b;
+        b.growthPolicy(growth);
+        for (uint32_t i = 0; i < state.size(); i += chunk)
+            b.append(payload + i, chunk);
+        doNotOptimize(b.const_data());
+    }
+}
+
+BENCHMARK(Buffer, appendChunked) { appendChunked(state, BufferGrowth::Triple); }
+BENCHMARK(Buffer, appendChunkedDouble) { appendChunked(state, BufferGrowth::Double); }
+BENCHMARK(Buffer, appendChunkedOneAndHalf) { appendChunked(state, BufferGrowth::OneAndHalf); }
+BENCHMARK(Buffer, appendChunkedPage) { appendChunked(state, BufferGrowth::Page); }
+
+// appendChunked with all reallocations served from a per-iteration monotonic arena, like a per-request arena
+BENCHMARK(Buffer, appendChunkedArena) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(16, state.size());
+    // triple growth allocates less than 4.5 times the final size in total
+    std::vector<uint8_t> arena(state.size() * 5 + 4096);
+
+    while (state.keepRunning()) {
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+        Buffer b(0, &resource);
+        for (uint32_t i = 0; i < state.size(); i += chunk)
+            b.append(payload + i, chunk);
+        doNotOptimize(b.const_data());
+    }
+}
+
+// overwrite the contents of a Buffer that is large enough already
+BENCHMARK(Buffer, write) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    Buffer b(state.size());
+
+    while (state.keepRunning()) {
+        b.write(payload, state.size(), 0);
+        doNotOptimize(b.const_data());
+    }
+}
+
+// stream the payload through a Buffer used as a queue: append a chunk, consume a chunk
+BENCHMARK(Buffer, appendConsume) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(CHUNK_SIZE, state.size());
+    Buffer b;
+
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < state.size(); i += chunk) {
+            b.append(payload + i, chunk);
+            // keep half a chunk queued so consume never fully drains the Buffer
+            b.consume(i == 0 ? chunk / 2 : chunk);
+        }
+        b.consume(b.size());
+        doNotOptimize(b.const_data());
+    }
+}
+
+// grow a full Buffer to twice its capacity, copying the contents and shredding the old allocation
+BENCHMARK(Buffer, increase) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        Buffer b(payload, state.size());
+        state.resumeTiming();
+
+        b.increase(state.size() * 2);
+        doNotOptimize(b.const_data());
+
+        // exclude the destructor's shredding of the new allocation
+        state.pauseTiming();
+        b = Buffer(0);
+        state.resumeTiming();
+    }
+}
+
+// copy a Buffer that grew to the payload size and holds at most 64 bytes afterwards, like a drained connection buffer
+BENCHMARK(Buffer, copyDrained) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    Buffer b(payload, state.size());
+    b.consume(state.size() - std::min<uint32_t>(64, state.size()));
+
+    while (state.keepRunning()) {
+        Buffer copy(b);
+        doNotOptimize(copy.const_data());
+    }
+}
+
+// hand a filled SecureUniquePtr over to a Buffer and back: copy its contents, or adopt and release the array
+BENCHMARK(Buffer, handOffCopy) {
+    SecureUniquePtr<uint8_t[]> data(state.size());
+    memcpy(data().get(), BenchmarkRunner::payload(state.size()), state.size());
+
+    while (state.keepRunning()) {
+        Buffer b(data().get(), state.size());
+        doNotOptimize(b.const_data());
+        memcpy(data().get(), b.const_data(), state.size());
+    }
+}
+
+BENCHMARK(Buffer, handOffAdopt) {
+    SecureUniquePtr<uint8_t[]> data(state.size());
+    memcpy(data().get(), BenchmarkRunner::payload(state.size()), state.size());
+
+    while (state.keepRunning()) {
+        Buffer b(std::move(data), state.size());
+        doNotOptimize(b.const_data());
+        data = b.release();
+    }
+}
+
+// reserve the payload size but hold only a 16 byte token, like a default sized Buffer holding a key
+BENCHMARK(Buffer, reserveToken) {
+    auto *payload = BenchmarkRunner::payload(16);
+
+    while (state.keepRunning()) {
+        Buffer b(state.size());
+        b.append(payload, std::min<uint32_t>(16, state.size()));
+        doNotOptimize(b.const_data());
+    }
+}
+
+// fill the payload, then shred it explicitly before destroying the Buffer
+BENCHMARK(Buffer, clearDestroy) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+
+    while (state.keepRunning()) {
+        Buffer b(payload, state.size());
+        b.clear(true);
+        doNotOptimize(b.const_data());
+    }
+}
+
+#ifndef _WIN32
+// stream the payload through a pipe in chunks and collect it in a Buffer: read into a stack array and append, or read
+// directly into the Buffer's free space
+static void pipeRead(BenchmarkState &state, bool direct) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(CHUNK_SIZE, state.size());
+    uint8_t tmp[CHUNK_SIZE];
+    Buffer b;
+
+    int fds[2];
+    if (pipe(fds) != 0)
+        return;
+
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < state.size(); i += chunk) {
+            if (write(fds[1], payload + i, chunk) != chunk)
+                return;
+
+            if (direct)
+                b.readFrom(fds[0], chunk);
+            else
+                b.append(tmp, static_cast<uint32_t>(read(fds[0], tmp, chunk)));
+        }
+        doNotOptimize(b.const_data());
+        b.clear();
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+BENCHMARK(Buffer, pipeReadAppend) { pipeRead(state, false); }
+BENCHMARK(Buffer, pipeReadFrom) { pipeRead(state, true); }
+#endif
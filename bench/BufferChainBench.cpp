@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <secure_memory/BufferChain.h>
+#include "Benchmark.h"
+
+// build the payload from small chunks, the BufferChain counterpart of Buffer/appendChunked
+BENCHMARK(BufferChain, appendChunked) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(16, state.size());
+
+    while (state.keepRunning()) {
+        BufferChain c;
+        for (uint32_t i = 0; i < state.size(); i += chunk)
+            c.append(payload + i, chunk);
+        doNotOptimize(c.segment(0).const_data());
+    }
+}
+
+// build the payload from small chunks, then consume it segment by segment
+BENCHMARK(BufferChain, appendConsume) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(16, state.size());
+
+    while (state.keepRunning()) {
+        BufferChain c;
+        for (uint32_t i = 0; i < state.size(); i += chunk)
+            c.append(payload + i, chunk);
+        while (!c.empty())
+            c.consume(c.segment(0).size());
+        doNotOptimize(c.size());
+    }
+}
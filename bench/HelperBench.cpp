@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/BufferRange.h>
+#include <secure_memory/helper.h>
+#include "Benchmark.h"
+
+// hash the whole payload
+BENCHMARK(Hash, bufferRange) {
+    Buffer in(BenchmarkRunner::payload(state.size()), state.size());
+    std::hash<const BufferRangeConst> hasher;
+
+    while (state.keepRunning())
+        doNotOptimize(hasher(in));
+}
+
+// compare two equal payloads, which is the worst case since every byte is inspected
+BENCHMARK(Helper, comparison) {
+    Buffer a(BenchmarkRunner::payload(state.size()), state.size()), b(a);
+
+    while (state.keepRunning())
+        doNotOptimize(comparisonHelper(a.const_data(), b.const_data(), a.size()));
+}
+
+// less-than of two equal payloads, which is the worst case since every byte is inspected
+BENCHMARK(Helper, less) {
+    Buffer a(BenchmarkRunner::payload(state.size()), state.size()), b(a);
+
+    while (state.keepRunning())
+        doNotOptimize(lessHelper(a.const_data(), a.size(), b.const_data(), b.size()));
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <secure_memory/Buffer.h>
+#include <secure_memory/MappedFile.h>
+#include "Benchmark.h"
+
+// stride of the reads touching the loaded data, one per page
+static constexpr size_t PAGE_STRIDE = 4096;
+
+// creates a temporary file holding the payload, returns its path
+static std::string payloadFile(size_t size) {
+    char path[] = "/tmp/secure_memory_bench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return {};
+
+    Buffer b(BenchmarkRunner::payload(size), static_cast<uint32_t>(size));
+    while (!b.empty() && b.writeTo(fd) > 0);
+    close(fd);
+    return path;
+}
+
+// sums one byte per page of the loaded data
+static uint8_t touch(const uint8_t *data, size_t size) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < size; i += PAGE_STRIDE)
+        sum += data[i];
+    return sum;
+}
+
+// read a file into a Buffer and access it
+BENCHMARK(MappedFile, readBuffer) {
+    std::string path = payloadFile(state.size());
+
+    while (state.keepRunning()) {
+        int fd = open(path.c_str(), O_RDONLY);
+        Buffer b(static_cast<uint32_t>(state.size()));
+        while (b.readFrom(fd, static_cast<uint32_t>(state.size() - b.size())) > 0);
+        close(fd);
+
+        doNotOptimize(touch(b.const_data(), b.size()));
+    }
+    unlink(path.c_str());
+}
+
+// map a file read-only and access it
+BENCHMARK(MappedFile, mapReadOnly) {
+    std::string path = payloadFile(state.size());
+
+    while (state.keepRunning()) {
+        MappedFile file(path);
+        doNotOptimize(touch(file.const_data(), file.size()));
+    }
+    unlink(path.c_str());
+}
+
+#endif
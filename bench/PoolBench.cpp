@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/SecureUniquePtr.h>
+#include "Benchmark.h"
+
+// number of short-lived arrays per iteration
+static constexpr uint32_t CHURN_COUNT = 64;
+
+// allocate and release arrays like keys and IVs, served by the calling thread's pool after the first iteration
+BENCHMARK(Pool, secureUniquePtr) {
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < CHURN_COUNT; i++) {
+            SecureUniquePtr<uint8_t[]> data(state.size());
+            data()[0] = static_cast<uint8_t>(i);
+            doNotOptimize(data().get());
+        }
+    }
+}
+
+// the same churn using the system allocator, the cost SecurePool avoids
+BENCHMARK(Pool, newShredDelete) {
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < CHURN_COUNT; i++) {
+            auto *data = new uint8_t[state.size()];
+            data[0] = static_cast<uint8_t>(i);
+            doNotOptimize(data);
+            MemoryShredder::shred(data, state.size());
+            delete[] data;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <secure_memory/RingBuffer.h>
+#include "Benchmark.h"
+
+// size of the chunks streamed through the FIFO, same as Buffer/appendConsume
+static constexpr uint32_t CHUNK_SIZE = 4096;
+
+// stream the payload through a fixed-size FIFO in chunks, the RingBuffer counterpart of Buffer/appendConsume
+BENCHMARK(RingBuffer, writeConsume) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t chunk = std::min<uint32_t>(CHUNK_SIZE, state.size());
+    // room for the half chunk kept queued plus one chunk
+    RingBuffer r(chunk * 2);
+
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < state.size(); i += chunk) {
+            r.write(payload + i, chunk);
+            // keep half a chunk queued so data wraps around the end of the allocation
+            r.consume(i == 0 ? chunk / 2 : chunk);
+        }
+        r.consume(r.size());
+        doNotOptimize(r.readable());
+    }
+}
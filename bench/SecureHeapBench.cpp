@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WIN32
+
+#include <sys/mman.h>
+
+#include <secure_memory/SecureHeap.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include "Benchmark.h"
+
+// number of short-lived arrays per iteration
+static constexpr uint32_t CHURN_COUNT = 64;
+
+// allocate and release locked arrays like keys and IVs, carved out of the heap's regions
+BENCHMARK(Heap, secureUniquePtr) {
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < CHURN_COUNT; i++) {
+            SecureUniquePtr<uint8_t[]> data(state.size(), SecureHeap::resource());
+            data()[0] = static_cast<uint8_t>(i);
+            doNotOptimize(data().get());
+        }
+    }
+}
+
+// the same churn locking every allocation on its own, the cost SecureHeap avoids
+BENCHMARK(Heap, mlockEach) {
+    while (state.keepRunning()) {
+        for (uint32_t i = 0; i < CHURN_COUNT; i++) {
+            auto *data = new uint8_t[state.size()];
+            mlock(data, state.size());
+            data[0] = static_cast<uint8_t>(i);
+            doNotOptimize(data);
+            MemoryShredder::shred(data, state.size());
+            munlock(data, state.size());
+            delete[] data;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <secure_memory/SharedBuffer.h>
+#include "Benchmark.h"
+
+// number of peers receiving the same message
+static constexpr uint32_t PEER_COUNT = 32;
+
+// fan a serialized message out to all peers, each receiving a deep copy
+BENCHMARK(SharedBuffer, fanOutCopy) {
+    Buffer message(BenchmarkRunner::payload(state.size()), state.size());
+    std::vector<Buffer> peers(PEER_COUNT);
+
+    while (state.keepRunning()) {
+        for (auto &peer : peers)
+            peer = Buffer(message);
+        doNotOptimize(peers.data());
+    }
+}
+
+// fan a serialized message out to all peers, each receiving a reference
+BENCHMARK(SharedBuffer, fanOutShared) {
+    SharedBuffer message(Buffer(BenchmarkRunner::payload(state.size()), state.size()));
+    std::vector<SharedBuffer> peers(PEER_COUNT);
+
+    while (state.keepRunning()) {
+        for (auto &peer : peers)
+            peer = message;
+        doNotOptimize(peers.data());
+    }
+}
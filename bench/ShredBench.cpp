@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <secure_memory/BackgroundShredder.h>
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include <secure_memory/SplitMix64.h>
+#include "Benchmark.h"
+
+// shred an allocation that is resident already
+static void shredResident(BenchmarkState &state, ShredStrategy strategy) {
+    SecureUniquePtr<uint8_t[]> data(state.size());
+    MemoryShredder::shred(data().get(), state.size(), strategy);
+
+    while (state.keepRunning()) {
+        MemoryShredder::shred(data().get(), state.size(), strategy);
+        clobberMemory();
+    }
+}
+
+// default strategy, selected by SECURE_MEMORY_SHRED_STRATEGY
+BENCHMARK(Shred, shred) {
+    shredResident(state, MemoryShredder::DEFAULT_STRATEGY);
+}
+
+BENCHMARK(Shred, zero) {
+    shredResident(state, ShredStrategy::Zero);
+}
+
+BENCHMARK(Shred, pattern) {
+    shredResident(state, ShredStrategy::Pattern);
+}
+
+BENCHMARK(Shred, prng) {
+    shredResident(state, ShredStrategy::PRNG);
+}
+
+// PRNG shred with the lanes advanced by each instruction set, limited to what the CPU supports
+static void shredResidentIsa(BenchmarkState &state, SplitMix64Isa isa) {
+    SplitMix64Isa original = SplitMix64x8::isa();
+    SplitMix64x8::isa(isa);
+    shredResident(state, ShredStrategy::PRNG);
+    SplitMix64x8::isa(original);
+}
+
+BENCHMARK(Shred, prngScalar) {
+    shredResidentIsa(state, SplitMix64Isa::Scalar);
+}
+
+BENCHMARK(Shred, prngAvx2) {
+    shredResidentIsa(state, SplitMix64Isa::AVX2);
+}
+
+BENCHMARK(Shred, prngAvx512) {
+    shredResidentIsa(state, SplitMix64Isa::AVX512);
+}
+
+// single SplitMix64, one word per dependent step
+BENCHMARK(Shred, prngSingleLane) {
+    SecureUniquePtr<uint8_t[]> data(state.size());
+    SplitMix64 rng(0x5ec0de);
+
+    while (state.keepRunning()) {
+        rng.nextBytes(data().get(), state.size());
+        clobberMemory();
+    }
+}
+
+BENCHMARK(Shred, csprng) {
+    shredResident(state, ShredStrategy::CSPRNG);
+}
+
+// latency of destroying a resident array on the releasing thread
+static void destroyResident(BenchmarkState &state) {
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        auto *data = new SecureUniquePtr<uint8_t[]>(state.size());
+        memset((*data)().get(), 0xAB, state.size());
+        state.resumeTiming();
+
+        delete data;
+    }
+}
+
+BENCHMARK(Shred, destroy) {
+    destroyResident(state);
+}
+
+// the same with large blocks deferred to the background thread
+BENCHMARK(Shred, destroyDeferred) {
+    BackgroundShredder::enabled(true);
+    destroyResident(state);
+    BackgroundShredder::enabled(false);
+}
+
+// shred resident page backed memory: overwrite every byte, or discard whole pages
+static void shredPages(BenchmarkState &state, bool discard) {
+    auto *data = static_cast<uint8_t *>(SecurePages::allocate(state.size()));
+
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        memset(data, 0xAB, state.size());
+        state.resumeTiming();
+
+        if (discard)
+            MemoryShredder::discard(data, state.size());
+        else
+            MemoryShredder::shred(data, state.size());
+        clobberMemory();
+    }
+
+    SecurePages::deallocate(data, state.size());
+}
+
+BENCHMARK(Shred, pagesWrite) {
+    shredPages(state, false);
+}
+
+BENCHMARK(Shred, pagesDiscard) {
+    shredPages(state, true);
+}
+
+// size of the working set of unrelated code, fits in L2 of most cores
+static constexpr size_t HOT_SET_SIZE = 256 * 1024;
+static constexpr size_t CACHE_LINE = 64;
+
+// latency of walking a hot working set after a large block was shredded on the same core. Lines are visited in
+// random order, each load depends on the previous one, so every line evicted by the shred costs a full miss.
+static void hotSetAfterShred(BenchmarkState &state, bool cached) {
+    size_t lines = HOT_SET_SIZE / CACHE_LINE;
+    std::vector<size_t> order(lines);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), SplitMix64(0x5ec0de));
+
+    // each line holds the index of the next one, forming a single cycle
+    std::unique_ptr<size_t[]> hot(new size_t[HOT_SET_SIZE / sizeof(size_t)]);
+    for (size_t i = 0; i < lines; i++)
+        hot[order[i] * CACHE_LINE / sizeof(size_t)] = order[(i + 1) % lines];
+
+    SecureUniquePtr<uint8_t[]> data(state.size());
+    SplitMix64x8 rng(0x5ec0de);
+    memset(data().get(), 0xAB, state.size());
+
+    state.bytesPerOp(HOT_SET_SIZE);
+    size_t next = 0;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (size_t i = 0; i < lines; i++)
+            next = hot[next * CACHE_LINE / sizeof(size_t)];
+
+        // the plain PRNG fill is what shred(..) does below MemoryShredder::NON_TEMPORAL_MIN_SIZE
+        if (cached)
+            rng.nextBytes(data().get(), state.size());
+        else
+            MemoryShredder::shred(data().get(), state.size(), ShredStrategy::PRNG);
+        clobberMemory();
+        state.resumeTiming();
+
+        for (size_t i = 0; i < lines; i++)
+            next = hot[next * CACHE_LINE / sizeof(size_t)];
+        doNotOptimize(next);
+    }
+}
+
+BENCHMARK(Shred, hotSetAfterCached) {
+    hotSetAfterShred(state, true);
+}
+
+BENCHMARK(Shred, hotSetAfterStreaming) {
+    hotSetAfterShred(state, false);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/String.h>
+#include "Benchmark.h"
+
+// concatenate two Strings of half the payload size each
+BENCHMARK(String, concat) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+    uint32_t half = state.size() / 2;
+    String a(payload, half), b(payload + half, state.size() - half);
+
+    while (state.keepRunning()) {
+        String c = a + b;
+        doNotOptimize(c.const_data());
+    }
+}
+
+// create a String and request its 0-terminated representation (c_str() accumulates copies per String)
+BENCHMARK(String, c_str) {
+    auto *payload = BenchmarkRunner::payload(state.size());
+
+    while (state.keepRunning()) {
+        String s(payload, state.size());
+        doNotOptimize(s.c_str());
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_BACKGROUNDSHREDDER_H
+#define SECUREMEMORY_BACKGROUNDSHREDDER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <secure_memory/MemoryShredder.h>
+
+/**
+ * Statistics of the BackgroundShredder.
+ */
+struct BackgroundShredderStats {
+    // blocks handed to the background thread
+    uint64_t deferred = 0;
+    // blocks shredded by the releasing thread, because the pending limit would have been exceeded
+    uint64_t synchronous = 0;
+    // releases that waited for space in the full queue
+    uint64_t stalls = 0;
+    // bytes queued or being shredded
+    size_t pending = 0;
+};
+
+/**
+ * Opt-in background thread that shreds and frees large blocks, moving that work off the releasing thread. Applies to
+ * blocks the SecurePool does not cache, i.e. blocks above SecurePool::MAX_BLOCK_SIZE, and to SecurePages blocks,
+ * which includes the heap storage of large Buffers.
+ *
+ * The queue holds at most maxQueued() blocks, releasing threads wait for space if it is full. Blocks that would raise
+ * the pending bytes above maxPending() are shredded synchronously instead. Disabling the shredder and program exit
+ * process all queued blocks first.
+ */
+class BackgroundShredder {
+public:
+    /**
+     * Shreds the leading dirty bytes of a block of size bytes with a strategy, then frees it.
+     */
+    using Release = void (*)(void *data, size_t size, ShredStrategy strategy, size_t dirty);
+
+    /**
+     * Default limit of queued blocks.
+     */
+    static constexpr size_t DEFAULT_MAX_QUEUED = 64;
+    /**
+     * Default limit of queued bytes.
+     */
+    static constexpr size_t DEFAULT_MAX_PENDING = 256 * 1024 * 1024;
+
+    /**
+     * @return True if the background thread is running
+     */
+    static bool enabled();
+    /**
+     * Starts or stops the background thread. Stopping it waits until all queued blocks are shredded and freed.
+     *
+     * @param enable Whether blocks are deferred to the background thread
+     */
+    static void enabled(bool enable);
+
+    /**
+     * Hands a block to the background thread, which shreds and frees it.
+     *
+     * @param data Block to release
+     * @param size Size of the block in bytes
+     * @param strategy Contents written over the block
+     * @param dirty Leading bytes of the block that may hold data, only these are shredded
+     * @param release Function shredding and freeing the block, nullptr for MemoryShredder::shred and operator delete
+     * @return True if the block is queued, false if the caller must shred and free it itself
+     */
+    static bool defer(void *data, size_t size, ShredStrategy strategy, size_t dirty = SIZE_MAX,
+                      Release release = nullptr);
+
+    /**
+     * Waits until all blocks queued so far are shredded and freed.
+     */
+    static void flush();
+
+    /**
+     * @return Limit of queued blocks
+     */
+    static size_t maxQueued();
+    /**
+     * Sets the limit of queued blocks. Releasing threads wait while the queue is full.
+     *
+     * @param blocks New limit, at least 1
+     */
+    static void maxQueued(size_t blocks);
+
+    /**
+     * @return Limit of queued bytes
+     */
+    static size_t maxPending();
+    /**
+     * Sets the limit of queued bytes. Blocks exceeding it are shredded synchronously, bounding the memory held by
+     * the queue.
+     *
+     * @param bytes New limit in bytes, 0 shreds all blocks synchronously
+     */
+    static void maxPending(size_t bytes);
+
+    /**
+     * @return Current statistics
+     */
+    static BackgroundShredderStats stats();
+    /**
+     * Resets deferred, synchronous and stall counters.
+     */
+    static void resetStats();
+};
+
+#endif //SECUREMEMORY_BACKGROUNDSHREDDER_H
@@ -19,8 +19,10 @@
 #ifndef SECUREMEMORY_BASEN_H
 #define SECUREMEMORY_BASEN_H
 
+#include <algorithm>
 #include <string>
 #include <numeric>
+#include <stdexcept>
 #include <cinttypes>
 
 #include "BufferRange.h"
@@ -92,20 +94,34 @@ public:
 
     public:
         /**
-         * Encodes a given BufferRangeConst in and writes the result to BufferRange out, which is moved forward.
+         * Encodes a given BufferView in and writes the result to BufferRange out, which is moved forward.
          * @param in Input to encode
          * @param out BufferRange that receives encoded data
+         * @throws std::length_error if the encoded data exceeds the maximum String size
          */
-        static void encode(const BufferRangeConst &in, BufferRange &out) {
+        static void encode(BufferView in, BufferRange &out) {
             constexpr auto t = createCodingTable<Base>(Alphabet, PaddingChar);
             const int mask = (1 << BitsPerChar) - 1;
 
-            // encoded result string
+            // upper bound of the encoded size: all input bits in characters, padded to full groups
+            uint64_t maxSize = (uint64_t(in.size()) * 8 + BitsPerChar - 1) / BitsPerChar;
+            maxSize = (maxSize + CharGroupSize - 1) / CharGroupSize * CharGroupSize;
+
+            if (maxSize > UINT32_MAX)
+                throw std::length_error("Encoded data exceeds maximum String size");
+
+            // encoded result string, written without initializing it first
             String result;
+            auto *o = reinterpret_cast<char *>(result.prepare(static_cast<uint32_t>(maxSize)).data());
+            // number of encoded characters
+            uint32_t outIx = 0;
+
             // current bit value of input, carried bit value of last input byte
             uint8_t bitVal = 0, carryBitVal = 0;
-            // input index, bits remaining in bitVal, size of carryBitVal
-            uint32_t inIx = 0, bitsRem = 0, carryBitSize = 0;
+            // input index
+            size_t inIx = 0;
+            // bits remaining in bitVal, size of carryBitVal
+            uint32_t bitsRem = 0, carryBitSize = 0;
 
             // while there are bytes in input, bits remaining in current input byte, or there is a carry value
             while (inIx < in.size() || bitsRem > 0 || carryBitSize > 0) {
@@ -114,7 +130,7 @@ public:
                     uint8_t b = (bitVal >> (bitsRem - BitsPerChar)) & mask;
                     size_t r = (carryBitVal << (BitsPerChar - carryBitSize)) + b;
 
-                    result.append(&t.encoding[r], 1);
+                    o[outIx++] = t.encoding[r];
                     bitsRem -= BitsPerChar;
                     carryBitVal = carryBitSize = 0;
                 } else {
@@ -131,49 +147,75 @@ public:
                     } else {
                         // pull in next byte from input
                         bitsRem += 8;
-                        bitVal = *in.const_data(inIx++);
+                        bitVal = in.data()[inIx++];
                     }
                 }
             }
 
             // add padding characters so that result size is divisible by group size
-            auto padCharCount = (CharGroupSize - (result.size() % CharGroupSize)) % CharGroupSize;
+            auto padCharCount = (CharGroupSize - (outIx % CharGroupSize)) % CharGroupSize;
             if (t.paddingChar != 0)
                 for (size_t i = 0; i < padCharCount; i++)
-                    result.append(&t.paddingChar, 1);
+                    o[outIx++] = t.paddingChar;
+
+            result.commit(outIx);
 
             out.write(result.const_data(), result.size());
             out += result.size();
         }
+        /**
+         * Encodes a given BufferRangeConst in and writes the result to BufferRange out, which is moved forward.
+         * @param in Input to encode
+         * @param out BufferRange that receives encoded data
+         */
+        static void encode(const BufferRangeConst &in, BufferRange &out) {
+            encode(in.view(), out);
+        }
+        /**
+         * Encodes a given BufferView in and writes the result to the underlying Buffer of BufferRange out.
+         * @param in Input to encode
+         * @param out Buffer that receives encoded data
+         */
+        static void encodeTo(BufferView in, BufferRange out) {
+            encode(in, out);
+        }
         /**
          * Encodes a given BufferRangeConst in and writes the result to the underlying Buffer of BufferRange out.
          * @param in Input to encode
          * @param out Buffer that receives encoded data
          */
         static void encodeTo(const BufferRangeConst &in, BufferRange out) {
-            encode(in, out);
+            encode(in.view(), out);
         }
         /**
-         * Encodes a given BufferRangeConst in and returns the encoded data.
+         * Encodes a given BufferView in and returns the encoded data.
          * @param in Input to encode
          * @return Encoded data
          */
-        static String encode(const BufferRangeConst &in) {
+        static String encode(BufferView in) {
             String result;
             encodeTo(in, result);
             return result;
         }
+        /**
+         * Encodes a given BufferRangeConst in and returns the encoded data.
+         * @param in Input to encode
+         * @return Encoded data
+         */
+        static String encode(const BufferRangeConst &in) {
+            return encode(in.view());
+        }
         /**
          * Encodes a given string and returns the encoded data.
          * @param in Input to encode
          * @return Encoded data
          */
         static std::string encodeString(const std::string &in) {
-            return encode(String(in)).stl_str();
+            return encode(BufferView(in)).stl_str();
         }
 
         /**
-         * Decodes a given BufferRangeConst in and writes the result to BufferRange out, which is moved forward. If
+         * Decodes a given BufferView in and writes the result to BufferRange out, which is moved forward. If
          * strict is enabled, decoding fails if it encounters an unknown character or invalid padding. In case of an
          * error, out is not modified.
          * @param in Input to decode
@@ -181,15 +223,23 @@ public:
          * @param strict Strict decoding
          * @return Decoding result. If false is returned, out is not modified.
          */
-        static bool decode(const BufferRangeConst &in, BufferRange &out, bool strict = false) {
+        static bool decode(BufferView in, BufferRange &out, bool strict = false) {
             constexpr auto t = createCodingTable<Base>(Alphabet, PaddingChar);
 
             // ensure input is correctly padded if strict requested and a padding character is set
             if (strict && t.paddingChar != 0 && (in.size() % CharGroupSize != 0))
                 return false;
 
-            // decoded result string
+            // decoded result string, written without initializing it first. Each character decodes to at most
+            // BitsPerChar bits
+            uint64_t maxSize = uint64_t(in.size()) * BitsPerChar / 8;
+            if (maxSize > UINT32_MAX)
+                return false;
+
             Buffer result;
+            auto *o = result.prepare(static_cast<uint32_t>(maxSize)).data();
+            // number of decoded bytes
+            uint32_t outIx = 0;
             // current bit value of input, carried bit value of last input byte
             uint8_t bitVal, carryBitVal = 0;
             // size of carryBitVal, tracking number of padding characters
@@ -199,9 +249,9 @@ public:
 
             for (size_t i = 0; i < in.size(); ++i) {
                 // decoded bit value of character
-                bitVal = t.decoding[*in.const_data(i)];
+                bitVal = t.decoding[in.data()[i]];
 
-                if (*in.const_data(i) == t.paddingChar) {
+                if (in.data()[i] == t.paddingChar) {
                     // if this is a padding character, take note of it
                     paddingCount++;
                     foundPadding = true;
@@ -223,7 +273,7 @@ public:
 
                     // only add decoded byte to result if it is no padding
                     if (paddingCount == 0)
-                        result.append(&d, 1);
+                        o[outIx++] = d;
                     else
                         paddingCount--;
 
@@ -236,12 +286,38 @@ public:
                 }
             }
 
+            result.commit(outIx);
             out.write(result.const_data(), result.size());
             out += result.size();
 
             return true;
         }
 
+        /**
+         * Decodes a given BufferRangeConst in and writes the result to BufferRange out, which is moved forward. If
+         * strict is enabled, decoding fails if it encounters an unknown character or invalid padding. In case of an
+         * error, out is not modified.
+         * @param in Input to decode
+         * @param out BufferRange that receives decoded data
+         * @param strict Strict decoding
+         * @return Decoding result. If false is returned, out is not modified.
+         */
+        static bool decode(const BufferRangeConst &in, BufferRange &out, bool strict = false) {
+            return decode(in.view(), out, strict);
+        }
+
+        /**
+         * Decodes a given BufferView in and writes the result to the underlying Buffer of out. If strict is
+         * enabled, decoding fails if it encounters an unknown character or invalid padding. In case of an error, out is
+         * not modified.
+         * @param in Input to decode
+         * @param out Buffer that receives decoded data
+         * @param strict Strict decoding
+         * @return Decoding result. If false is returned, out is not modified.
+         */
+        static bool decodeFrom(BufferView in, BufferRange out, bool strict = false) {
+            return decode(in, out, strict);
+        }
         /**
          * Decodes a given BufferRangeConst in and writes the result to the underlying Buffer of out. If strict is
          * enabled, decoding fails if it encounters an unknown character or invalid padding. In case of an error, out is
@@ -252,7 +328,7 @@ public:
          * @return Decoding result. If false is returned, out is not modified.
          */
         static bool decodeFrom(const BufferRangeConst &in, BufferRange out, bool strict = false) {
-            return decode(in, out, strict);
+            return decode(in.view(), out, strict);
         }
         /**
          * Decodes a given String and returns the decoded data. If strict is enabled, decoding fails if it encounters
@@ -274,7 +350,9 @@ public:
          * @return Decoded data or empty string if decoding failed.
          */
         static std::string decodeString(const std::string &in, bool strict = false) {
-            return String(decode(String(in), strict)).stl_str();
+            Buffer result;
+            decodeFrom(BufferView(in), result, strict);
+            return {result.const_data<char>(), result.size()};
         }
     };
 
@@ -20,79 +20,170 @@
 #ifndef SECUREMEMORY_BUFFER_H
 #define SECUREMEMORY_BUFFER_H
 
+#ifndef _WIN32
+    #include <sys/types.h>
+#endif
+
+#include "BufferView.h"
 #include "ISerializable.h"
 #include "SecureUniquePtr.h"
 #include "Range.h"
 #include "SafeInt.h"
 
-class Buffer;
+template<typename SizeT>
+class BasicBuffer;
+using Buffer = BasicBuffer<uint32_t>;
+using Buffer64 = BasicBuffer<uint64_t>;
 using BufferRange = Range<Buffer>;
 using BufferRangeConst = Range<const Buffer>;
+using Buffer64Range = Range<Buffer64, uint64_t>;
+using Buffer64RangeConst = Range<const Buffer64, uint64_t>;
+
+/**
+ * Strategies for computing a Buffer's new capacity when a write exceeds its current capacity. More aggressive growth
+ * trades memory for fewer reallocations.
+ */
+enum class BufferGrowth : uint8_t {
+    /// Requested size plus twice the current capacity (default)
+    Triple,
+    /// Twice the current capacity, at least the requested size
+    Double,
+    /// 1.5 times the current capacity, at least the requested size
+    OneAndHalf,
+    /// Exactly the requested size
+    Exact,
+    /// Requested size rounded up to a multiple of the system's page size
+    Page,
+};
+
+/**
+ * Reallocation statistics of a single Buffer, used to choose a BufferGrowth policy for a workload. Only tracked if
+ * built with SECURE_MEMORY_BUFFER_STATS, otherwise all counters stay 0.
+ */
+struct BufferStats {
+    // number of reallocations performed
+    uint32_t reallocations = 0;
+    // number of bytes copied from old to new allocations
+    uint64_t bytesCopied = 0;
+    // number of in-place compactions performed instead of reallocations
+    uint32_t compactions = 0;
+    // number of bytes moved to the front by compactions
+    uint64_t bytesMoved = 0;
+};
+
+/**
+ * Variable size binary buffer on the heap, or inline for small sizes. All managed memory is shredded when released.
+ *
+ * Heap memory comes from the SecurePool, or from SecurePages for allocations of at least SecurePages::MIN_SIZE bytes,
+ * which grow by remapping instead of copying. A std::pmr::memory_resource passed on construction replaces both.
+ * Copies allocate from the same resource, moves transfer the memory together with its resource. Pass
+ * SecureHeap::resource() to keep the data and all its copies in locked memory.
+ *
+ * @tparam SizeT Unsigned type of sizes and offsets, which limits the capacity: Buffer uses uint32_t, Buffer64 uint64_t
+ */
+template<typename SizeT>
+class BasicBuffer : public ISerializable {
+    static_assert(std::is_unsigned<SizeT>::value, "Buffer size type must be unsigned");
 
-class Buffer : public ISerializable {
 public:
+    // Ranges within Buffers of this size type
+    using BufferRange = Range<BasicBuffer, SizeT>;
+    using BufferRangeConst = Range<const BasicBuffer, SizeT>;
+
+    /**
+     * Capacity in bytes up to which a Buffer's data is stored inline in the Buffer object instead of the heap.
+     */
+    static constexpr uint32_t INLINE_SIZE = 32;
+
     /**
-     * Creates a Buffer object with a default internal buffer size of 512 bytes.
+     * Creates an empty Buffer object. No memory is allocated or shredded until data is written.
      */
-    Buffer();
+    BasicBuffer();
     /**
-     * Creates a Buffer object with an internal buffer of reserved size.
+     * Creates a Buffer object with an internal buffer of reserved size. Buffers of up to INLINE_SIZE bytes do not
+     * allocate unless they use the SecureHeap, a reserved size of 0 defers allocation until data is written.
      *
      * @param reserved Initial buffer capacity in bytes.
+     * @param resource Memory resource for all heap allocations of this Buffer, which must outlive it. nullptr selects
+     * the default allocation.
      */
-    explicit Buffer(uint32_t reserved);
+    explicit BasicBuffer(SizeT reserved, std::pmr::memory_resource *resource = nullptr);
     /**
      * Creates a Buffer object from a byte sequence, copying it's contents
      *
      * @param bytes Byte sequence
      * @param size The size in bytes
      */
-    explicit Buffer(const void *data, uint32_t size);
+    explicit BasicBuffer(const void *data, SizeT size);
+    /**
+     * Creates a Buffer object that takes ownership of an array, without copying it. The array's size becomes the
+     * capacity, its memory resource the Buffer's resource.
+     *
+     * @param data Array to adopt
+     * @param used Number of used bytes at the beginning of the array, limited to its size
+     */
+    BasicBuffer(SecureUniquePtr<uint8_t[]> &&data, SizeT used);
     /**
      * Creates a Buffer object from a BufferRangeConst
      *
      * @param range The buffer range containing the data to copy
      */
-    explicit Buffer(const BufferRangeConst &range);
+    explicit BasicBuffer(const BufferRangeConst &range);
+    /**
+     * Creates a Buffer object from a view, copying it's contents. Views exceeding the maximum size are truncated.
+     *
+     * @param view View of the data to copy
+     */
+    explicit BasicBuffer(BufferView view);
     /**
      * Creates a Buffer object from an STL string (std::string), copying it's contents
      * @param stl_str The std::string object
      */
-    Buffer(const std::string &stl_str); // NOLINT(google-explicit-constructor)
+    BasicBuffer(const std::string &stl_str); // NOLINT(google-explicit-constructor)
+    /**
+     * Creates a Buffer object from another Buffer (deep-copy). The copy's capacity is the other Buffer's size plus
+     * its copy slack, regardless of the other Buffer's capacity. The copy allocates from the other Buffer's resource.
+     *
+     * @param buffer A reference to the buffer to be copied
+     */
+    BasicBuffer(const BasicBuffer &buffer);
     /**
-     * Creates a Buffer object from another Buffer (deep-copy).
+     * Creates a Buffer object from another Buffer (deep-copy) like the copy constructor, allocating from a memory
+     * resource.
      *
      * @param buffer A reference to the buffer to be copied
+     * @param resource Memory resource for all heap allocations of this Buffer, which must outlive it. nullptr selects
+     * the default allocation.
      */
-    Buffer(const Buffer &buffer);
+    BasicBuffer(const BasicBuffer &buffer, std::pmr::memory_resource *resource);
     /**
-     * Move constructor. Other Buffer will be left in default state.
+     * Move constructor. Other Buffer will be left in default state, without allocated memory.
      *
      * @param buffer Other buffer's rvalue reference
      */
-    Buffer(Buffer &&buffer) noexcept;
+    BasicBuffer(BasicBuffer &&buffer) noexcept;
 
     /**
      * Destructor
      */
-    virtual ~Buffer();
+    virtual ~BasicBuffer();
 
     /**
      * Appends a bunch of data to the Buffer; increases it's capacity if necessary.
      *
-     * Capacity is at least double the capacity before.
+     * Capacity is increased according to the Buffer's growth policy.
      * @param data Data pointer
      * @param len Length of data (in bytes)
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst append(const void *data, uint32_t len);
+    BufferRangeConst append(const void *data, SizeT len);
     /**
      * Overload variant of append which appends the contents of another buffer to this buffer.
      *
      * @param other Other Buffer
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst append(const Buffer &other);
+    BufferRangeConst append(const BasicBuffer &other);
     /**
      * Overload variant of append which appends the contents of another buffer described by a Range to this buffer.
      *
@@ -100,6 +191,14 @@ public:
      * @return Range containing information about added range within Buffer
      */
     BufferRangeConst append(const BufferRangeConst &range);
+    /**
+     * Overload variant of append which appends the contents of a view, e.g. of a std::string_view or memory-mapped
+     * file. Views exceeding the maximum size are truncated.
+     *
+     * @param view View of the data to append
+     * @return Range containing information about added range within Buffer
+     */
+    BufferRangeConst append(BufferView view);
     /**
      * Variant of append which appends a single fundamental value for convenience.
      *
@@ -121,7 +220,7 @@ public:
      * @param offset Starting position
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst write(const void *data, uint32_t len, uint32_t offset = 0);
+    BufferRangeConst write(const void *data, SizeT len, SizeT offset = 0);
     /**
      * Overload variant of write which writes the contents of another buffer to this buffer.
      *
@@ -129,7 +228,7 @@ public:
      * @param offset Starting position
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst write(const Buffer &other, uint32_t offset = 0);
+    BufferRangeConst write(const BasicBuffer &other, SizeT offset = 0);
     /**
      * Overload variant of write which writes the contents of another buffer described by a Range to this buffer.
      *
@@ -137,7 +236,7 @@ public:
      * @param offset Starting position
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst write(const BufferRange &other, uint32_t offset = 0);
+    BufferRangeConst write(const BufferRange &other, SizeT offset = 0);
     /**
      * Overload variant of write which writes the contents of another buffer described by a Range to this buffer.
      *
@@ -145,7 +244,7 @@ public:
      * @param offset Starting position
      * @return Range containing information about added range within Buffer
      */
-    BufferRangeConst write(const BufferRangeConst &other, uint32_t offset = 0);
+    BufferRangeConst write(const BufferRangeConst &other, SizeT offset = 0);
 
     /**
      * Consumes n bytes from the beginning, moving the Buffer's beginning and shrinking the size;
@@ -153,28 +252,46 @@ public:
      *
      * @param n The number of bytes to consume
      */
-    void consume(uint32_t n);
+    void consume(SizeT n);
 
     /**
      * Reduces consumed bytes count, increasing the size.
      *
      * @param n Number of bytes to un-consume
      */
-    void unconsume(uint32_t n = 0);
+    void unconsume(SizeT n = 0);
 
     /**
      * Marks n bytes used at the end of the buffer. This increases the size.
      *
      * @param n Number of bytes to use
      */
-    void use(uint32_t n);
+    void use(SizeT n);
 
     /**
      * Reduces used bytes from the end, shrinking the size.
      *
      * @param n Number of bytes to un-use
      */
-    void unuse(uint32_t n);
+    void unuse(SizeT n);
+
+    /**
+     * Prepares n bytes of free capacity behind the used bytes for writing, growing according to the growth policy if
+     * necessary. The memory is not initialized and does not become part of the Buffer until it is committed. The view
+     * is invalidated by any operation that changes the capacity.
+     *
+     * @param n Number of bytes to prepare
+     * @return Writable view of the prepared bytes
+     */
+    MutableBufferView prepare(SizeT n);
+    /**
+     * Marks n prepared bytes used, appending them to the Buffer. Limited to the free capacity.
+     *
+     * @param n Number of bytes written to the view returned by prepare(..)
+     */
+    inline void commit(SizeT n) {
+        use(n);
+    }
 
     /**
      * Increases buffer capacity to newCapacity if necessary.
@@ -183,7 +300,7 @@ public:
      * @param by True if newCapacity is relative to size() or false if not (default)
      * @return New capacity
      */
-    uint32_t increase(uint32_t newCapacity, bool by = false);
+    SizeT increase(SizeT newCapacity, bool by = false);
     /**
      * Overload variant of increase which initializes newly allocated memory to value.
      *
@@ -191,7 +308,119 @@ public:
      * @param by True if newCapacity is relative to size() or false if not (default)
      * @return New capacity
      */
-    uint32_t increase(uint32_t newCapacity, uint8_t value, bool by = false);
+    SizeT increase(SizeT newCapacity, uint8_t value, bool by = false);
+
+    /**
+     * Hands the Buffer's storage out as an array, leaving the Buffer in default state without allocated memory. Used
+     * bytes are moved to the beginning of the array, read size() beforehand to know their number. Heap storage is
+     * released without copying, small Buffers copy their data into a new array.
+     *
+     * @return Array holding the used bytes
+     */
+    SecureUniquePtr<uint8_t[]> release();
+
+    /**
+     * Reduces the capacity to the size, releasing unused and consumed memory. Heap storage is reallocated and the old
+     * allocation shredded, small data moves to the inline storage and an empty Buffer releases its allocation.
+     */
+    void shrink_to_fit();
+
+    /**
+     * @return Number of bytes the Buffer can hold without reallocating, starting at its current beginning.
+     */
+    SizeT capacity() const;
+
+    /**
+     * @return Growth policy applied when a write exceeds the capacity
+     */
+    inline BufferGrowth growthPolicy() const {
+        return mPolicy.growth;
+    }
+    /**
+     * Sets the growth policy applied when a write exceeds the capacity. Explicit calls to increase(..) are not
+     * affected by the policy.
+     *
+     * @param growth New growth policy
+     */
+    inline void growthPolicy(BufferGrowth growth) {
+        mPolicy.growth = growth;
+    }
+
+    /**
+     * @return Memory resource of this Buffer's heap allocations, nullptr for the default allocation
+     */
+    inline std::pmr::memory_resource *resource() const {
+        // large default allocations come from SecurePages, which is not a resource chosen for the Buffer
+        std::pmr::memory_resource *resource = mData.resource();
+        return resource == SecurePages::resource() ? nullptr : resource;
+    }
+
+    /**
+     * @return Contents written over memory released by this Buffer
+     */
+    inline ShredStrategy shredStrategy() const {
+        return mData.shredStrategy();
+    }
+    /**
+     * Sets the contents written over memory released by this Buffer, including its current allocation. Copies and
+     * moves keep the strategy.
+     *
+     * @param strategy New shred strategy
+     */
+    void shredStrategy(ShredStrategy strategy);
+
+    /**
+     * @return Compaction threshold in percent of the allocation
+     */
+    inline uint8_t compactionThreshold() const {
+        return mPolicy.compactionThreshold;
+    }
+    /**
+     * Sets the compaction threshold. If consumed bytes make up at least threshold percent of the allocation and the
+     * requested capacity fits into the allocation, increasing the capacity moves the used bytes to the front instead
+     * of reallocating. A fully consumed Buffer is always compacted. Values above 100 disable compaction of Buffers
+     * that still hold data.
+     *
+     * @param threshold Threshold in percent of the allocation, defaults to 50
+     */
+    inline void compactionThreshold(uint8_t threshold) {
+        mPolicy.compactionThreshold = threshold;
+    }
+
+    /**
+     * @return Free capacity in bytes reserved by copies of this Buffer on top of its size
+     */
+    inline SizeT copySlack() const {
+        return mPolicy.copySlack;
+    }
+    /**
+     * Sets the free capacity reserved by copies on top of the size. Copies inherit the setting.
+     *
+     * @param slack Free capacity in bytes, defaults to 0. Limited to UINT32_MAX.
+     */
+    inline void copySlack(SizeT slack) {
+        mPolicy.copySlack = static_cast<uint32_t>(std::min<uint64_t>(slack, UINT32_MAX));
+    }
+
+    /**
+     * @return Reallocation statistics of this Buffer, all 0 unless built with SECURE_MEMORY_BUFFER_STATS
+     */
+    inline const BufferStats &stats() const {
+#ifdef SECURE_MEMORY_BUFFER_STATS
+        return mStats;
+#else
+        static const BufferStats none;
+        return none;
+#endif
+    }
+    /**
+     * Resets the reallocation statistics of this Buffer.
+     */
+    inline void resetStats() {
+#ifdef SECURE_MEMORY_BUFFER_STATS
+        mStats = {};
+#endif
+    }
 
     /**
      * Adds padded bytes with specified value to the Buffer (starting at offset), so that Buffer is newSize long. Padded
@@ -201,14 +430,14 @@ public:
      * @param size Number of bytes to add
      * @param value Byte value of padded bytes
      */
-    void padd(uint32_t offset, uint32_t size, uint8_t value);
+    void padd(SizeT offset, SizeT size, uint8_t value);
     /**
      * Overload variant of padd which starts at end.
      *
      * @param newSize Buffer's new size
      * @param value Byte value of padded bytes
      */
-    void padd(uint32_t newSize, uint8_t value);
+    void padd(SizeT newSize, uint8_t value);
     /**
      * Overload variant of padd which accepts a Range.
      *
@@ -220,7 +449,7 @@ public:
     /**
      * @return Size of the Buffer.
      */
-    uint32_t size() const;
+    SizeT size() const;
 
     /**
      * @return True if the Buffer is empty.
@@ -234,7 +463,7 @@ public:
      *
      * @param p Offset into used data to start at. Defaults to 0.
      */
-    const void *const_data_raw(uint32_t p = 0) const;
+    const void *const_data_raw(SizeT p = 0) const;
     /**
      * Returns a typed constant data pointer to the buffer data at offset p.
      *
@@ -243,7 +472,7 @@ public:
      * @return Typed pointer into buffer.
      */
     template<typename T = uint8_t>
-    const T *const_data(uint32_t p = 0) const {
+    const T *const_data(SizeT p = 0) const {
         return static_cast<const T *>(const_data_raw(p));
     }
     /**
@@ -252,14 +481,22 @@ public:
      * @param offset The byte to start the Range from
      * @param size Range's size
      */
-    BufferRangeConst const_data(uint32_t offset, uint32_t size) const;
+    BufferRangeConst const_data(SizeT offset, SizeT size) const;
+    /**
+     * @return View of the used bytes, which is valid until the Buffer is modified
+     */
+    inline BufferView view() const {
+        return {const_data(), size()};
+    }
 
     /**
-     * Returns a mutable data pointer to the buffer data at offset p.
+     * Returns a mutable data pointer to the buffer data at offset p. The whole storage is considered written from
+     * then on and is shredded on release, since the pointer may be used to write to the free capacity. Use
+     * prepare(..) to write only as much as needed.
      *
      * @param p Offset into used data to start at. Defaults to 0.
      */
-    void *data_raw(uint32_t p = 0);
+    void *data_raw(SizeT p = 0);
     /**
      * Returns a typed mutable data pointer to the buffer data at offset p.
      *
@@ -268,7 +505,7 @@ public:
      * @return Typed, mutable pointer into buffer.
      */
     template<typename T = uint8_t>
-    T *data(uint32_t p = 0) {
+    T *data(SizeT p = 0) {
         return static_cast<T *>(data_raw(p));
     }
 
@@ -278,7 +515,7 @@ public:
      * @param offset The byte to start the Range from
      * @param size Range's size
      */
-    BufferRange data(uint32_t offset, uint32_t size);
+    BufferRange data(SizeT offset, SizeT size);
 
     /**
      * Returns an instance of T from buffer data at offset p
@@ -287,7 +524,7 @@ public:
      * @return An instance of T
      */
     template<typename T = uint8_t>
-    T at(uint32_t p = 0) const {
+    T at(SizeT p = 0) const {
         return *const_data<T>(p);
     }
 
@@ -314,7 +551,16 @@ public:
      * @param other
      * @return True if contents of Buffers are the same
      */
-    bool operator==(const Buffer &other) const;
+    bool operator==(const BasicBuffer &other) const;
+    /**
+     * Compares the contents of this Buffer with a view
+     *
+     * @param other View to compare with
+     * @return True if their sizes and contents are equal
+     */
+    inline bool operator==(BufferView other) const {
+        return view() == other;
+    }
     /**
      * Compares two Buffers.
      *
@@ -322,7 +568,16 @@ public:
      * @param other
      * @return True if contents of Buffers differ
      */
-    inline bool operator!=(const Buffer &other) const {
+    inline bool operator!=(const BasicBuffer &other) const {
+        return !operator==(other);
+    }
+    /**
+     * Compares the contents of this Buffer with a view
+     *
+     * @param other View to compare with
+     * @return True if their sizes or contents differ
+     */
+    inline bool operator!=(BufferView other) const {
         return !operator==(other);
     }
 
@@ -342,7 +597,7 @@ public:
      * @return *this
      * @see Buffer::Buffer(Buffer &&)
      */
-    Buffer &operator=(Buffer &&other) noexcept;
+    BasicBuffer &operator=(BasicBuffer &&other) noexcept;
     /**
      * Copy assignment operator, similar to copy constructor.
      *
@@ -350,7 +605,7 @@ public:
      * @return *this
      * @see Buffer::Buffer(const Buffer &)
      */
-    Buffer &operator=(const Buffer &other) noexcept;
+    BasicBuffer &operator=(const BasicBuffer &other) noexcept;
 
     /**
      * Compares two Buffers by byte values.
@@ -361,7 +616,7 @@ public:
      * @param other Buffer to compare to this Buffer
      * @return True if the content in this buffer is "less-than" the content in other
      */
-    inline bool operator<(const Buffer &other) const {
+    inline bool operator<(const BasicBuffer &other) const {
         return lessHelper(const_data_raw(), size(), other.const_data_raw(), other.size());
     }
 
@@ -387,7 +642,7 @@ public:
      *
      * @param out Buffer to append serialization to
      */
-    void serializeAppend(Buffer &out) const {
+    void serializeAppend(BasicBuffer &out) const {
         serializeTo(out.end());
     }
 
@@ -410,35 +665,222 @@ public:
         return deserialize(in);
     }
 
+#ifndef _WIN32
+    /**
+     * Reads up to max bytes from a file descriptor directly into the free space behind the used bytes. Capacity is
+     * increased according to the Buffer's growth policy if necessary. Read bytes are marked as used.
+     *
+     * @param fd File descriptor to read from
+     * @param max Maximum number of bytes to read
+     * @return Number of bytes read, 0 on end of file or -1 on error (see errno). Fails with EINVAL without reading
+     * if max is 0 or the Buffer cannot grow.
+     */
+    ssize_t readFrom(int fd, SizeT max);
+    /**
+     * Writes the used bytes to a file descriptor and consumes the bytes written. After a partial write, the Buffer
+     * holds the remaining bytes.
+     *
+     * @param fd File descriptor to write to
+     * @return Number of bytes written or -1 on error (see errno)
+     */
+    ssize_t writeTo(int fd);
+
+    /**
+     * Scatter variant of readFrom, which reads into the free space of multiple Buffers in order with a single
+     * system call. Capacities are not increased, reserve space with increase(..) beforehand. At most IO_VECTORS
+     * Buffers are used.
+     *
+     * @param fd File descriptor to read from
+     * @param buffers Buffers to read into
+     * @param count Number of Buffers
+     * @return Number of bytes read, 0 on end of file or -1 on error (see errno)
+     */
+    static ssize_t readFrom(int fd, BasicBuffer *const *buffers, size_t count);
+    /**
+     * Gather variant of writeTo, which writes the used bytes of multiple Buffers in order with a single system call
+     * and consumes the bytes written. At most IO_VECTORS Buffers are used.
+     *
+     * @param fd File descriptor to write to
+     * @param buffers Buffers to write
+     * @param count Number of Buffers
+     * @return Number of bytes written or -1 on error (see errno)
+     */
+    static ssize_t writeTo(int fd, BasicBuffer *const *buffers, size_t count);
+
+    /**
+     * Maximum number of Buffers used by a single scatter or gather call.
+     */
+    static constexpr size_t IO_VECTORS = 64;
+#endif
+
     /**
      * Implementation of Swappable concept, used for std::swap.
      *
      * @param one
      * @param two
      */
-    friend void swap(Buffer &one, Buffer &two) {
-        secure_memory::swap(one.mData, two.mData);
-        secure_memory::swap(one.mReserved, two.mReserved);
-        secure_memory::swap(one.mUsed, two.mUsed);
-        secure_memory::swap(one.mOffset, two.mOffset);
+    friend void swap(BasicBuffer &one, BasicBuffer &two) {
+        // inline storage cannot be swapped by pointer, the move operations copy it
+        BasicBuffer tmp(std::move(one));
+        one = std::move(two);
+        two = std::move(tmp);
     }
 
 private:
-    // internal data
+    using Deleter = SecureUniquePtr<uint8_t[]>::Deleter;
+
+    /**
+     * Ensures the capacity is at least needed by compacting or growing according to the growth policy.
+     *
+     * @param needed Bytes required, relative to the current beginning
+     */
+    void ensureCapacity(SafeInt<SizeT> needed);
+    /**
+     * Computes the new capacity for a write exceeding the current capacity according to the growth policy.
+     *
+     * @param needed Bytes required, relative to the current beginning
+     * @return New capacity, relative to the current beginning
+     */
+    SafeInt<SizeT> grow(SafeInt<SizeT> needed);
+    /**
+     * Moves the used bytes to the front of the allocation, if the consumed bytes exceed the compaction threshold and
+     * the requested capacity fits into the allocation afterwards.
+     *
+     * @param capa Requested capacity, relative to the current beginning
+     * @return True if the Buffer has been compacted
+     */
+    bool compact(SafeInt<SizeT> capa);
+
+    /**
+     * @return Memory resource for a heap allocation of size bytes: the Buffer's resource, or SecurePages for large
+     * allocations with the default allocation
+     */
+    inline std::pmr::memory_resource *allocationResource(SizeT size) const {
+        std::pmr::memory_resource *resource = this->resource();
+        return resource == nullptr && size >= SecurePages::MIN_SIZE ? SecurePages::resource() : resource;
+    }
+    /**
+     * Grows page backed heap storage by remapping it, keeping the offset.
+     *
+     * @param capa Requested capacity, relative to the current beginning
+     * @return True if the storage has been remapped
+     */
+    bool remap(SafeInt<SizeT> capa);
+
+    /**
+     * @return Capacity of the inline storage, 0 on the SecureHeap, which must hold all data in locked memory
+     */
+    inline uint32_t inlineSize() const {
+        return mData.resource() == SecureHeap::resource() ? 0 : INLINE_SIZE;
+    }
+
+    /**
+     * @return True if the data is stored inline
+     */
+    inline bool isInline() const {
+        return !mData() && mData.size() != 0;
+    }
+    /**
+     * @return The heap data, the inline storage or nullptr if nothing is allocated
+     */
+    inline uint8_t *storage() {
+        return mData() ? mData().get() : isInline() ? mInline : nullptr;
+    }
+    /**
+     * @return The heap data, the inline storage or nullptr if nothing is allocated (const)
+     */
+    inline const uint8_t *storage() const {
+        return mData() ? mData().get() : isInline() ? mInline : nullptr;
+    }
+    /**
+     * @return Number of reserved bytes of the storage. Adopted arrays beyond the maximum size are limited to it.
+     */
+    inline SafeInt<SizeT> reserved() const {
+        return make_si(static_cast<SizeT>(std::min<uint64_t>(mData.size(), std::numeric_limits<SizeT>::max())));
+    }
+    /**
+     * Releases the heap storage, if any, and switches to inline storage of reserved bytes, or to the unallocated
+     * state for 0. The resource and shred strategy are kept.
+     *
+     * @param reserved Capacity of the inline storage, at most INLINE_SIZE
+     * @param dirty Bytes at the beginning of the inline storage that hold data
+     */
+    void resetStorage(SizeT reserved, SizeT dirty);
+
+    /**
+     * Raises the dirty high-water mark, which the deleter uses to shred only bytes that ever held data.
+     *
+     * @param end End of written bytes, relative to the beginning of the storage
+     */
+    inline void markDirty(SizeT end) {
+        if (end > mData.dirty())
+            mData.dirty(end);
+    }
+
+    /**
+     * Counts a reallocation in the statistics, if they are tracked.
+     *
+     * @param copied Bytes copied to the new allocation
+     */
+    inline void countReallocation(SizeT copied) {
+#ifdef SECURE_MEMORY_BUFFER_STATS
+        mStats.reallocations++;
+        mStats.bytesCopied += copied;
+#else
+        (void) copied;
+#endif
+    }
+    /**
+     * Counts a compaction in the statistics, if they are tracked.
+     *
+     * @param moved Bytes moved to the front
+     */
+    inline void countCompaction(SizeT moved) {
+#ifdef SECURE_MEMORY_BUFFER_STATS
+        mStats.compactions++;
+        mStats.bytesMoved += moved;
+#else
+        (void) moved;
+#endif
+    }
+
+    /**
+     * Settings applied when growing, compacting and copying, kept together in 8 bytes.
+     */
+    struct Policy {
+        // growth policy applied in write(..)
+        BufferGrowth growth = BufferGrowth::Triple;
+        // consumed percentage of the allocation that allows compaction
+        uint8_t compactionThreshold = 50;
+        // free capacity reserved by copies
+        uint32_t copySlack = 0;
+    };
+
+    // internal heap data, empty if inline storage is used. Its deleter holds the reserved and dirty bytes, resource and
+    // shred strategy in every state: a size of 0 without heap data means nothing is allocated, otherwise inline storage.
     SecureUniquePtr<uint8_t[]> mData;
-    // size of data, number of reserved bytes
-    SafeInt<uint32_t> mReserved;
+    // inline storage for small buffers
+    uint8_t mInline[INLINE_SIZE];
     // offset of used bytes in data
-    SafeInt<uint32_t> mOffset {0};
+    SafeInt<SizeT> mOffset {0};
     // used bytes in data, beginning at offset
-    SafeInt<uint32_t> mUsed {0};
+    SafeInt<SizeT> mUsed {0};
+    // growth, compaction and copy settings
+    Policy mPolicy;
+#ifdef SECURE_MEMORY_BUFFER_STATS
+    // reallocation statistics
+    BufferStats mStats;
+#endif
 };
 
+extern template class BasicBuffer<uint32_t>;
+extern template class BasicBuffer<uint64_t>;
+
 namespace std {
     /// Implement hash function for Buffer, so that it is a usable key in STL containers
-    template<>
-    struct hash<const Buffer> {
-        std::size_t operator()(const Buffer &k) const;
+    template<typename SizeT>
+    struct hash<const BasicBuffer<SizeT>> {
+        std::size_t operator()(const BasicBuffer<SizeT> &k) const;
     };
 }
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_BUFFERCHAIN_H
+#define SECUREMEMORY_BUFFERCHAIN_H
+
+#include <deque>
+#include <vector>
+
+#include "Buffer.h"
+#include "BufferView.h"
+
+/**
+ * Byte sequence stored as a chain of Buffer segments. Appending never copies existing data, because full segments are
+ * left in place and new segments are added at the end. Consuming whole segments releases (and shreds) them without
+ * moving the remaining data. Suited for building and streaming payloads too large to reallocate cheaply.
+ */
+class BufferChain {
+public:
+    /**
+     * Default capacity of segments allocated by append.
+     */
+    static constexpr uint32_t DEFAULT_SEGMENT_SIZE = 64 * 1024;
+
+    /**
+     * Creates an empty BufferChain. No memory is allocated until data is appended.
+     *
+     * @param segmentSize Capacity in bytes of segments allocated by append
+     */
+    explicit BufferChain(uint32_t segmentSize = DEFAULT_SEGMENT_SIZE);
+    /**
+     * Creates a BufferChain from another BufferChain (deep-copy of all segments).
+     *
+     * @param other BufferChain to copy
+     */
+    BufferChain(const BufferChain &other) = default;
+    /**
+     * Move constructor. Other BufferChain will be left empty. Not noexcept, since std::deque may allocate when it
+     * is moved from.
+     *
+     * @param other Other BufferChain's rvalue reference
+     */
+    BufferChain(BufferChain &&other);
+
+    BufferChain &operator=(const BufferChain &other) = default;
+    BufferChain &operator=(BufferChain &&other) noexcept;
+
+    /**
+     * Appends data to the chain. Fills the free space of the last segment first, then allocates new segments.
+     *
+     * @param data Data pointer
+     * @param len Length of data (in bytes)
+     */
+    void append(const void *data, uint64_t len);
+    /**
+     * Overload variant of append which appends the contents of a Range.
+     *
+     * @param range Range describing the data to append
+     */
+    void append(const BufferRangeConst &range);
+    /**
+     * Appends a Buffer as a new segment without copying its data. Empty Buffers are ignored.
+     *
+     * @param segment Buffer to take over
+     */
+    void append(Buffer &&segment);
+
+    /**
+     * Consumes n bytes from the beginning. Fully consumed segments are released, the first remaining segment is
+     * consumed partially.
+     *
+     * @param n Number of bytes to consume, limited by size()
+     */
+    void consume(uint64_t n);
+
+    /**
+     * Copies up to len bytes starting at offset to out.
+     *
+     * @param out Destination pointer
+     * @param len Maximum number of bytes to copy
+     * @param offset Offset into the chain to start at
+     * @return Number of bytes copied
+     */
+    uint64_t copyTo(void *out, uint64_t len, uint64_t offset = 0) const;
+    /**
+     * @return Contiguous copy of the chain's data. A Buffer64, since chains may exceed the maximum size of a Buffer.
+     */
+    Buffer64 flatten() const;
+
+    /**
+     * Returns Ranges on the segments covering size bytes starting at offset, limited to the chain's data.
+     *
+     * @param offset Offset into the chain to start at
+     * @param size Number of bytes to cover
+     * @return Constant Ranges in chain order
+     */
+    std::vector<BufferRangeConst> const_data(uint64_t offset, uint64_t size) const;
+    /**
+     * @return Views of all segments' data in chain order, suitable for scatter/gather I/O. Valid until the chain is
+     * modified.
+     */
+    std::vector<BufferView> views() const;
+
+    /**
+     * @param i Index of the segment, less than segmentCount()
+     * @return Segment at index i
+     */
+    inline const Buffer &segment(size_t i) const {
+        return mSegments[i];
+    }
+    /**
+     * @return Number of segments
+     */
+    inline size_t segmentCount() const {
+        return mSegments.size();
+    }
+    /**
+     * @return Capacity of segments allocated by append
+     */
+    inline uint32_t segmentSize() const {
+        return mSegmentSize;
+    }
+
+    /**
+     * @return Number of bytes in the chain
+     */
+    inline uint64_t size() const {
+        return mSize;
+    }
+    /**
+     * @return True if the chain is empty
+     */
+    inline bool empty() const {
+        return mSize == 0;
+    }
+
+    /**
+     * Releases all segments, shredding their memory.
+     */
+    void clear();
+
+private:
+    // segments in chain order, none of them empty
+    std::deque<Buffer> mSegments;
+    // capacity of new segments
+    uint32_t mSegmentSize;
+    // sum of all segments' sizes
+    uint64_t mSize = 0;
+};
+
+#endif //SECUREMEMORY_BUFFERCHAIN_H
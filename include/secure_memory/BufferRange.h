@@ -22,9 +22,14 @@
 
 #include "Range.h"
 
-class Buffer;
+template<typename SizeT>
+class BasicBuffer;
+using Buffer = BasicBuffer<uint32_t>;
+using Buffer64 = BasicBuffer<uint64_t>;
 using BufferRange = Range<Buffer>;
 using BufferRangeConst = Range<const Buffer>;
+using Buffer64Range = Range<Buffer64, uint64_t>;
+using Buffer64RangeConst = Range<const Buffer64, uint64_t>;
 
 #include "Buffer.h"
 
@@ -34,22 +39,11 @@ namespace std {
     /**
      * Implement hash function for Range class (so that Range is usable in a hash map)
      */
-    template<>
-    struct hash<const BufferRangeConst> {
-        SM_NO_SANITIZE std::size_t operator()(const BufferRangeConst &k) const {
-            using std::size_t;
-            using std::hash;
-            using std::string;
-
-            // Compute individual hash values for first,
-            // second and third and combine them using XOR
-            // and bit shifting:
-
-            // taken from https://stackoverflow.com/questions/2590677/how-do-i-combine-hash-values-in-c0x
-            size_t current = 0;
-            for (uint32_t a = 0; a < k.size(); a++)
-                current ^= *k.const_data(a) + 0x9e3779b9UL + (current << 6u) + (current >> 2u);
-            return current;
+    template<typename SizeT>
+    struct hash<const Range<const BasicBuffer<SizeT>, SizeT>> {
+        std::size_t operator()(const Range<const BasicBuffer<SizeT>, SizeT> &k) const {
+            // same as the hash of a BufferView of the same data
+            return hashHelper(k.const_data(), k.size());
         }
     };
 }
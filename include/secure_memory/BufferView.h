@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_BUFFERVIEW_H
+#define SECUREMEMORY_BUFFERVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#if __has_include(<span>)
+    #include <span>
+#endif
+
+#include "helper.h"
+
+/**
+ * Non-owning view of a contiguous memory region (pointer + size). The viewed memory must outlive the view.
+ *
+ * Read-only views convert implicitly from std::string_view and std::span (if available), so functions taking a
+ * BufferView process such data in place. std::string converts explicitly, e.g. BufferView(str). Buffers, Ranges,
+ * MappedFiles and SharedBuffers provide view().
+ *
+ * @tparam T Byte type, const for read-only views
+ */
+template<typename T>
+class BasicBufferView {
+public:
+    /**
+     * Creates an empty view.
+     */
+    constexpr BasicBufferView() = default;
+    /**
+     * Creates a view of size bytes starting at data.
+     *
+     * @param data Pointer to the first byte
+     * @param size Size in bytes
+     */
+    constexpr BasicBufferView(T *data, size_t size) : mData(data), mSize(size) { }
+    /**
+     * Converts a mutable view into a read-only view.
+     *
+     * @param other View to convert
+     */
+    template<typename U, typename = std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value>>
+    constexpr BasicBufferView(const BasicBufferView<U> &other) : mData(other.data()), mSize(other.size()) { } // NOLINT(google-explicit-constructor)
+    /**
+     * Creates a read-only view of a string's characters.
+     *
+     * @param str String to view
+     */
+    template<typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    BasicBufferView(std::string_view str) // NOLINT(google-explicit-constructor)
+            : mData(reinterpret_cast<T *>(str.data())), mSize(str.size()) { }
+#ifdef __cpp_lib_span
+    /**
+     * Creates a view of a span of bytes.
+     *
+     * @param span Span of byte-sized elements, const for read-only views
+     */
+    template<typename U, size_t N,
+             typename = std::enable_if_t<sizeof(U) == 1 && (std::is_const<T>::value || !std::is_const<U>::value)>>
+    constexpr BasicBufferView(std::span<U, N> span) // NOLINT(google-explicit-constructor)
+            : mData(reinterpret_cast<T *>(span.data())), mSize(span.size()) { }
+#endif
+
+    /**
+     * @return Pointer to the first byte
+     */
+    constexpr T *data() const {
+        return mData;
+    }
+    /**
+     * @return Size in bytes
+     */
+    constexpr size_t size() const {
+        return mSize;
+    }
+    /**
+     * @return True if the view is empty
+     */
+    constexpr bool empty() const {
+        return mSize == 0;
+    }
+
+    /**
+     * Creates a view of a part of this view. Offset and size are limited to this view.
+     *
+     * @param offset Offset of the new view relative to this view
+     * @param size Size of the new view
+     * @return New view
+     */
+    constexpr BasicBufferView subview(size_t offset, size_t size = SIZE_MAX) const {
+        if (offset > mSize)
+            offset = mSize;
+        if (size > mSize - offset)
+            size = mSize - offset;
+
+        return {mData + offset, size};
+    }
+
+private:
+    // first byte of the viewed region
+    T *mData = nullptr;
+    // size of the viewed region
+    size_t mSize = 0;
+};
+
+using BufferView = BasicBufferView<const uint8_t>;
+using MutableBufferView = BasicBufferView<uint8_t>;
+
+/**
+ * Compares the contents of two views
+ *
+ * @return True if their sizes and contents are equal
+ */
+inline bool operator==(BufferView a, BufferView b) {
+    return a.size() == b.size() && comparisonHelper(a.data(), b.data(), a.size());
+}
+/**
+ * Compares the contents of two views
+ *
+ * @return True if their sizes or contents differ
+ */
+inline bool operator!=(BufferView a, BufferView b) {
+    return !(a == b);
+}
+/**
+ * Compares the contents of two views lexicographically
+ *
+ * @return True if a is less than b
+ */
+inline bool operator<(BufferView a, BufferView b) {
+    return lessHelper(a.data(), a.size(), b.data(), b.size());
+}
+
+namespace std {
+    /// Implement hash function for BufferView, equal to the hash of Buffers and Ranges of the same data
+    template<>
+    struct hash<BufferView> {
+        std::size_t operator()(BufferView k) const {
+            return hashHelper(k.data(), k.size());
+        }
+    };
+}
+
+#endif //SECUREMEMORY_BUFFERVIEW_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_MAPPEDFILE_H
+#define SECUREMEMORY_MAPPEDFILE_H
+
+#ifndef _WIN32
+
+#include <string>
+#include <vector>
+
+#include "BufferView.h"
+#include "Range.h"
+
+class MappedFile;
+using MappedFileRange = Range<MappedFile, uint64_t>;
+using MappedFileRangeConst = Range<const MappedFile, uint64_t>;
+
+/**
+ * File mapped into memory, giving access to its contents without reading them into a Buffer. The accessors follow
+ * Buffer's, so Ranges work on top of a MappedFile. POSIX only.
+ *
+ * In ReadOnly mode, the mapping is shared with the page cache and cannot be modified. In Private mode, modifications
+ * are copy-on-write and never reach the file. Modified (dirty) pages are tracked individually and shredded before
+ * unmapping, while clean pages are not touched, so they are never copied. Mutable pointers mark all pages up to the
+ * end dirty, since their extent is unknown; on Linux, /proc/self/pagemap tells which of them have actually been
+ * copied, so only those are shredded.
+ *
+ * A MappedFileRangeConst is not a BufferRangeConst. Consumers taking a BufferView, like Buffer::append(..) and BaseN,
+ * process mapped data in place through view(..) or Range::view().
+ */
+class MappedFile {
+public:
+    /**
+     * Access modes of a mapping.
+     */
+    enum class Mode : uint8_t {
+        /// Read-only, zero-copy access
+        ReadOnly,
+        /// Writable private copy-on-write mapping, dirty pages are shredded on unmap
+        Private,
+    };
+
+    /**
+     * Creates an unmapped MappedFile.
+     */
+    MappedFile() = default;
+    /**
+     * Maps the file at path. Check isMapped() for success.
+     *
+     * @param path Path of the file to map
+     * @param mode Access mode
+     */
+    explicit MappedFile(const std::string &path, Mode mode = Mode::ReadOnly);
+    /**
+     * Move constructor. Other MappedFile will be left unmapped.
+     *
+     * @param other Other MappedFile's rvalue reference
+     */
+    MappedFile(MappedFile &&other) noexcept;
+    /**
+     * Move assignment. Our mapping is unmapped first, other MappedFile will be left unmapped.
+     *
+     * @param other Other MappedFile's rvalue reference
+     * @return Reference to this MappedFile
+     */
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * Unmaps the file, shredding dirty pages.
+     */
+    ~MappedFile();
+
+    /**
+     * Maps the file at path, unmapping the current mapping first.
+     *
+     * @param path Path of the file to map
+     * @param mode Access mode
+     * @return True on success, false otherwise (see errno)
+     */
+    bool map(const std::string &path, Mode mode = Mode::ReadOnly);
+    /**
+     * Overload variant of map which maps an open file descriptor. The descriptor is not closed.
+     *
+     * @param fd File descriptor of the file to map
+     * @param mode Access mode
+     * @return True on success, false otherwise (see errno)
+     */
+    bool map(int fd, Mode mode = Mode::ReadOnly);
+    /**
+     * Unmaps the file. In Private mode, dirty pages are shredded first.
+     */
+    void unmap();
+
+    /**
+     * @return True if a file is mapped
+     */
+    inline bool isMapped() const {
+        return mMapped;
+    }
+    /**
+     * @return Access mode of the mapping
+     */
+    inline Mode mode() const {
+        return mMode;
+    }
+
+    /**
+     * @return Size of the mapped file
+     */
+    inline uint64_t size() const {
+        return mSize;
+    }
+    /**
+     * @return True if the mapped file is empty or nothing is mapped
+     */
+    inline bool empty() const {
+        return mSize == 0;
+    }
+
+    /**
+     * Returns a constant data pointer to the mapped data at offset p.
+     *
+     * @param p Offset to start at. Defaults to 0.
+     */
+    const void *const_data_raw(uint64_t p = 0) const;
+    /**
+     * Returns a typed constant data pointer to the mapped data at offset p.
+     *
+     * @tparam T Type of data pointed to by result.
+     * @param p Offset to start at. Defaults to 0.
+     * @return Typed pointer into the mapping.
+     */
+    template<typename T = uint8_t>
+    const T *const_data(uint64_t p = 0) const {
+        return static_cast<const T *>(const_data_raw(p));
+    }
+    /**
+     * Returns a constant Range object from offset with size, limited to the mapping.
+     *
+     * @param offset The byte to start the Range from
+     * @param size Range's size
+     */
+    MappedFileRangeConst const_data(uint64_t offset, uint64_t size) const;
+
+    /**
+     * Returns a mutable data pointer to the mapped data at offset p. Marks everything from p to the end dirty, prefer
+     * data(offset, size) or write(..) if only part of it is modified.
+     *
+     * @param p Offset to start at. Defaults to 0.
+     * @return Mutable pointer into the mapping, nullptr if the mode is not Private
+     */
+    void *data_raw(uint64_t p = 0);
+    /**
+     * Returns a typed mutable data pointer to the mapped data at offset p. Marks everything from p to the end dirty.
+     *
+     * @tparam T Type of data pointed to by result
+     * @param p Offset to start at. Defaults to 0.
+     * @return Typed, mutable pointer into the mapping, nullptr if the mode is not Private
+     */
+    template<typename T = uint8_t>
+    T *data(uint64_t p = 0) {
+        return static_cast<T *>(data_raw(p));
+    }
+    /**
+     * Returns a mutable Range object from offset with size, limited to the mapping. Marks the Range dirty. Only valid
+     * in Private mode.
+     *
+     * @param offset The byte to start the Range from
+     * @param size Range's size
+     */
+    MappedFileRange data(uint64_t offset, uint64_t size);
+
+    /**
+     * Overwrites mapped data at offset, limited to the mapping. Does nothing if the mode is not Private.
+     *
+     * @param data Data pointer
+     * @param len Length of data (in bytes)
+     * @param offset Starting position
+     */
+    void write(const void *data, uint64_t len, uint64_t offset = 0);
+
+    /**
+     * @return View of the whole mapping
+     */
+    inline BufferView view() const {
+        return {static_cast<const uint8_t *>(mData), static_cast<size_t>(mSize)};
+    }
+    /**
+     * Returns a view from offset with size, limited to the mapping.
+     *
+     * @param offset The byte to start the view from
+     * @param size View's size
+     * @return View into the mapping
+     */
+    BufferView view(uint64_t offset, uint64_t size) const;
+
+    /**
+     * @param offset Offset into the mapping
+     * @return True if the page containing offset has been marked dirty and will be shredded on unmap
+     */
+    bool isDirty(uint64_t offset) const;
+
+private:
+    /**
+     * Marks the pages overlapping [begin, end) dirty.
+     */
+    void markDirty(uint64_t begin, uint64_t end);
+
+    // start of the mapping, nullptr if nothing or an empty file is mapped
+    uint8_t *mData = nullptr;
+    // size of the mapped file
+    uint64_t mSize = 0;
+    // whether a file is mapped
+    bool mMapped = false;
+    // access mode of the mapping
+    Mode mMode = Mode::ReadOnly;
+    // one flag per page that may have been modified, empty until the first modification
+    std::vector<bool> mDirtyPages;
+};
+
+#endif
+
+#endif //SECUREMEMORY_MAPPEDFILE_H
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_MEMORYSHREDDER_H
+#define SECUREMEMORY_MEMORYSHREDDER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <secure_memory/SplitMix64x8.h>
+
+// default strategy, selected by CMake
+#ifndef SECURE_MEMORY_SHRED_STRATEGY
+    #define SECURE_MEMORY_SHRED_STRATEGY PRNG
+#endif
+
+/**
+ * Contents written over memory before it is released. Ordered by cost, see bench/ShredBench.cpp.
+ */
+enum class ShredStrategy : uint8_t {
+    /// Zero fill, vectorized by memset
+    Zero,
+    /// Fill with MemoryShredder::PATTERN, which tells shredded memory apart from zeroed memory
+    Pattern,
+    /// Fill with bytes of a fast, non-cryptographic per-thread PRNG (SplitMix64x8)
+    PRNG,
+    /// Fill with bytes of the operating system's cryptographically secure random number generator
+    CSPRNG,
+};
+
+/**
+ * Overwrites memory before it is released, in a way the compiler cannot optimize away.
+ */
+class MemoryShredder {
+public:
+    /**
+     * Strategy used unless another one is selected, set by the CMake option SECURE_MEMORY_SHRED_STRATEGY.
+     */
+    static constexpr ShredStrategy DEFAULT_STRATEGY = ShredStrategy::SECURE_MEMORY_SHRED_STRATEGY;
+    /**
+     * Byte value written by ShredStrategy::Pattern.
+     */
+    static constexpr uint8_t PATTERN = 0xA5;
+    /**
+     * Size in bytes from which discard(..) releases whole pages instead of overwriting them.
+     */
+    static constexpr size_t DISCARD_MIN_SIZE = 1024 * 1024;
+    /**
+     * Size in bytes from which shred(..) writes with non-temporal stores, which bypass the cache. Shredding larger
+     * ranges through the cache would evict the working set of other code on the same core. Smaller ranges are
+     * likely cache resident, where streaming them out costs more than overwriting them in place.
+     */
+    static constexpr size_t NON_TEMPORAL_MIN_SIZE = 1024 * 1024;
+
+    /**
+     * Overwrites len bytes at data. Ranges of at least NON_TEMPORAL_MIN_SIZE bytes are written with non-temporal
+     * stores on x86 with SSE2, followed by a store fence. Does nothing if built without SECURE_MEMORY_UNIQUE_PTR_SHRED.
+     *
+     * @param data Memory to overwrite, may be nullptr
+     * @param len Size in bytes
+     * @param strategy Contents to overwrite the memory with
+     */
+    static void shred(void *data, size_t len, ShredStrategy strategy = DEFAULT_STRATEGY);
+    /**
+     * Shreds private anonymous memory, e.g. SecurePages blocks. Ranges of at least DISCARD_MIN_SIZE bytes have their
+     * whole pages discarded with madvise(MADV_DONTNEED) on Linux, which releases the physical pages without writing
+     * them and makes the range read as zeros. Partial pages at the edges are shredded like shred(..) does. Falls back
+     * to shred(..) elsewhere and for smaller ranges.
+     *
+     * Discarded pages return to the kernel, which clears them before they are handed out again.
+     *
+     * @param data Memory to overwrite, must be part of a private anonymous mapping. May be nullptr.
+     * @param len Size in bytes
+     * @param strategy Contents written over the partial pages
+     */
+    static void discard(void *data, size_t len, ShredStrategy strategy = DEFAULT_STRATEGY);
+
+private:
+    static thread_local SplitMix64x8 sRng;
+};
+
+#endif //SECUREMEMORY_MEMORYSHREDDER_H
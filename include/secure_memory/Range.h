@@ -22,10 +22,17 @@
 
 #include <limits>
 
+#include "BufferView.h"
 #include "SafeInt.h"
 #include "helper.h"
 
-template <typename O>
+/**
+ * Region (offset, size) within an object providing size(), const_data(..) and data(..), such as a Buffer.
+ *
+ * @tparam O Type of the underlying object
+ * @tparam SizeT Unsigned type of offsets and sizes, must match the object's
+ */
+template <typename O, typename SizeT = uint32_t>
 class Range {
 public:
     /**
@@ -36,7 +43,7 @@ public:
      * @param size Range's size
      * @param resizable Defines if the Range is resizable
      */
-    Range(O &obj, uint32_t offset, uint32_t size, bool resizable = false)
+    Range(O &obj, SizeT offset, SizeT size, bool resizable = false)
             : mObj(obj), mOffset(offset), mSize(size), mResizable(resizable) { }
     /**
      * Overload constructor with offset = 0 and size = OBJ_END
@@ -51,7 +58,7 @@ public:
      * @param other Other range to copy from
      */
     template<typename P>
-    explicit Range(Range<P> &other)
+    explicit Range(Range<P, SizeT> &other)
             : Range(other.mObj, other.mOffset, other.mSize, other.mResizable) { }
 
     /**
@@ -70,26 +77,26 @@ public:
     /**
      * @return Size
      */
-    inline uint32_t size() const {
+    inline SizeT size() const {
         return (mSize == +OBJ_END ? mObj.size() - offset() : mSize);
     }
     /**
      * Set size
      */
-    inline void size(uint32_t size) {
+    inline void size(SizeT size) {
         mSize = size;
     }
 
     /**
      * @return Offset
      */
-    inline uint32_t offset() const {
+    inline SizeT offset() const {
         return mOffset;
     }
     /**
      * Set offset
      */
-    inline void offset(uint32_t offset) {
+    inline void offset(SizeT offset) {
         mOffset = offset;
     }
 
@@ -115,7 +122,7 @@ public:
      * @param pos Offset (defaults to 0)
      */
     template<typename T = uint8_t>
-    inline const T *const_data(uint32_t pos = 0) const {
+    inline const T *const_data(SizeT pos = 0) const {
         return const_object().template const_data<T>(make_si(pos) + mOffset);
     }
     /**
@@ -126,9 +133,15 @@ public:
      * @param sz Size of new Range
      * @return New constant Range on the same object with specified offset and size
      */
-    Range<O> const_data(uint32_t off, uint32_t sz) const {
+    Range<O, SizeT> const_data(SizeT off, SizeT sz) const {
         return const_object().const_data(mOffset + make_si(off), sz);
     }
+    /**
+     * @return View of this Range's data, which is valid as long as the underlying object's data is
+     */
+    inline BufferView view() const {
+        return {const_data(), size()};
+    }
 
     /**
      * Get mutable, typed pointer to underlying data at offset
@@ -137,7 +150,7 @@ public:
      * @param pos Offset (defaults to 0)
      */
     template<typename T = uint8_t>
-    inline T *data(uint32_t pos = 0) {
+    inline T *data(SizeT pos = 0) {
         return object().template data<T>(make_si(pos) + mOffset);
     }
     /**
@@ -148,7 +161,7 @@ public:
      * @param sz Size of new Range
      * @return New mutable Range on the same object with specified offset and size
      */
-    Range<O> data(uint32_t off, uint32_t sz) {
+    Range<O, SizeT> data(SizeT off, SizeT sz) {
         return object().data(mOffset + make_si(off), sz);
     }
 
@@ -159,7 +172,7 @@ public:
      * @param size Size of data
      * @param off Offset relative to this Range's to write to in underlying object. Defaults to 0.
      */
-    inline void write(const void *data, uint32_t size, uint32_t off = 0) {
+    inline void write(const void *data, SizeT size, SizeT off = 0) {
         object().write(data, size, mOffset + make_si(off));
     }
 
@@ -187,7 +200,7 @@ public:
      * @param addition Amount of bytes to move
      * @return this
      */
-    Range &operator+=(uint32_t addition) {
+    Range &operator+=(SizeT addition) {
         if (addition > size())
             addition = size();
 
@@ -203,7 +216,7 @@ public:
      * @param size Target size
      * @return True if Range has the required size or can be increased to size
      */
-    bool ensureSize(uint32_t sz) {
+    bool ensureSize(SizeT sz) {
         // not enough size and not resizable -> fail
         if (sz > size() && !isResizable())
             return false;
@@ -218,19 +231,19 @@ public:
     }
 
     // constant for size sticking to the end
-    const static uint32_t OBJ_END = std::numeric_limits<uint32_t>::max();
+    static constexpr SizeT OBJ_END = std::numeric_limits<SizeT>::max();
 
 protected:
     // allow Ranges with different type protected access
-    template<typename P>
+    template<typename P, typename S>
     friend class Range;
 
     // object holding underlying range data
     O &mObj;
     // offset into object, start of range
-    SafeInt<uint32_t> mOffset;
+    SafeInt<SizeT> mOffset;
     // size of object range, starting at offset
-    SafeInt<uint32_t> mSize;
+    SafeInt<SizeT> mSize;
     // whether the underlying object allows resizing the range
     bool mResizable = false;
 };
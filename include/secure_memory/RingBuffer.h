@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_RINGBUFFER_H
+#define SECUREMEMORY_RINGBUFFER_H
+
+#include "Buffer.h"
+#include "BufferView.h"
+#include "SecureUniquePtr.h"
+
+/**
+ * Fixed-capacity byte FIFO that wraps around at the end of its allocation. Unlike a Buffer used with append and
+ * consume, it never reallocates or moves data. The allocation is shredded on destruction like any SecureUniquePtr.
+ *
+ * Readable and writable bytes are exposed as up to two contiguous regions each, so data can be produced and consumed
+ * in place: fill writable() and commit(n), then process readable() and consume(n).
+ */
+class RingBuffer {
+public:
+    /**
+     * Up to two contiguous regions of a RingBuffer. The second region is only non-empty if the first one ends at the
+     * end of the allocation.
+     *
+     * @tparam V View type of the regions
+     */
+    template<typename V>
+    struct Regions {
+        V first;
+        V second;
+
+        /**
+         * @return Total size of both regions in bytes
+         */
+        inline size_t size() const {
+            return first.size() + second.size();
+        }
+    };
+
+    /**
+     * Creates a RingBuffer that holds up to capacity bytes.
+     *
+     * @param capacity Capacity in bytes
+     */
+    explicit RingBuffer(uint32_t capacity);
+    /**
+     * Move constructor. Other RingBuffer will be left empty, without allocated memory.
+     *
+     * @param other Other RingBuffer's rvalue reference
+     */
+    RingBuffer(RingBuffer &&other) noexcept;
+    /**
+     * Move assignment. Our memory is shredded, other RingBuffer will be left empty, without allocated memory.
+     *
+     * @param other Other RingBuffer's rvalue reference
+     * @return Reference to this RingBuffer
+     */
+    RingBuffer &operator=(RingBuffer &&other) noexcept;
+
+    /**
+     * Writes up to len bytes to the end of the FIFO, limited by available().
+     *
+     * @param data Data pointer
+     * @param len Length of data (in bytes)
+     * @return Number of bytes written
+     */
+    uint32_t write(const void *data, uint32_t len);
+    /**
+     * Overload variant of write which writes the contents of a Range.
+     *
+     * @param range Range describing the data to write
+     * @return Number of bytes written
+     */
+    uint32_t write(const BufferRangeConst &range);
+
+    /**
+     * Copies up to len bytes from the beginning of the FIFO to out and consumes them.
+     *
+     * @param out Destination pointer
+     * @param len Maximum number of bytes to read
+     * @return Number of bytes read
+     */
+    uint32_t read(void *out, uint32_t len);
+    /**
+     * Overload variant of read which appends up to len bytes to a Buffer and consumes them.
+     *
+     * @param out Buffer to append to
+     * @param len Maximum number of bytes to read
+     * @return Number of bytes read
+     */
+    uint32_t read(Buffer &out, uint32_t len);
+    /**
+     * Copies up to len bytes starting at offset from the beginning of the FIFO to out without consuming them.
+     *
+     * @param out Destination pointer
+     * @param len Maximum number of bytes to copy
+     * @param offset Offset into readable bytes to start at
+     * @return Number of bytes copied
+     */
+    uint32_t peek(void *out, uint32_t len, uint32_t offset = 0) const;
+
+    /**
+     * Consumes n bytes from the beginning of the FIFO. Consumed bytes are discarded and will be overwritten by
+     * subsequent writes.
+     *
+     * @param n Number of bytes to consume, limited by size()
+     */
+    void consume(uint32_t n);
+    /**
+     * Marks n bytes at the beginning of writable() as readable, after they have been filled in place.
+     *
+     * @param n Number of bytes to commit, limited by available()
+     */
+    void commit(uint32_t n);
+
+    /**
+     * @return Readable bytes in FIFO order, valid until the next consume or clear
+     */
+    Regions<BufferView> readable() const;
+    /**
+     * @return Free space in FIFO order, valid until the next commit, write or clear
+     */
+    Regions<MutableBufferView> writable();
+
+    /**
+     * @return Number of readable bytes
+     */
+    inline uint32_t size() const {
+        return mSize;
+    }
+    /**
+     * @return Number of bytes that can be written before the FIFO is full
+     */
+    inline uint32_t available() const {
+        return capacity() - mSize;
+    }
+    /**
+     * @return Maximum number of bytes the FIFO holds
+     */
+    inline uint32_t capacity() const {
+        return static_cast<uint32_t>(mData.size());
+    }
+    /**
+     * @return True if there are no readable bytes
+     */
+    inline bool empty() const {
+        return mSize == 0;
+    }
+    /**
+     * @return True if no bytes can be written
+     */
+    inline bool full() const {
+        return mSize == capacity();
+    }
+
+    /**
+     * @return Contents written over the memory of this RingBuffer
+     */
+    inline ShredStrategy shredStrategy() const {
+        return mData.shredStrategy();
+    }
+    /**
+     * Sets the contents written over the memory of this RingBuffer when it is cleared with shredding or released.
+     * Moves keep the strategy.
+     *
+     * @param strategy New shred strategy
+     */
+    inline void shredStrategy(ShredStrategy strategy) {
+        mData.shredStrategy(strategy);
+    }
+
+    /**
+     * Clears the FIFO.
+     *
+     * @param shred Whether to overwrite all managed memory (slows down operation)
+     */
+    void clear(bool shred = false);
+
+private:
+    // index of the first readable byte, always less than capacity unless capacity is 0
+    uint32_t mHead = 0;
+    // number of readable bytes
+    uint32_t mSize = 0;
+
+    SecureUniquePtr<uint8_t[]> mData;
+};
+
+#endif //SECUREMEMORY_RINGBUFFER_H
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SECUREHEAP_H
+#define SECUREMEMORY_SECUREHEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <secure_memory/MemoryShredder.h>
+
+/**
+ * Statistics of the SecureHeap.
+ */
+struct SecureHeapStats {
+    // bytes of locked memory held by the heap, excluding guard pages
+    size_t locked = 0;
+    // locked bytes handed out, rounded up to size classes or pages
+    size_t used = 0;
+    // locked bytes available for allocation
+    size_t free = 0;
+    // number of memory mappings, each surrounded by guard pages
+    size_t mappings = 0;
+    // blocks handed out since program start
+    uint64_t allocations = 0;
+};
+
+/**
+ * Heap of locked memory for secrets. Memory is reserved in regions of REGION_SIZE bytes, which are locked into RAM
+ * (mlock), excluded from core dumps (MADV_DONTDUMP where available) and surrounded by inaccessible guard pages. Small
+ * blocks of up to MAX_BLOCK_SIZE are carved out of the regions in power of two size classes, so locking costs one
+ * system call per region instead of one per allocation. Larger blocks get their own guarded mapping.
+ *
+ * Blocks are shredded when freed. Regions are kept for reuse until program exit, dedicated mappings are released.
+ * Allocations throw std::bad_alloc if memory cannot be locked, e.g. because RLIMIT_MEMLOCK is exhausted.
+ *
+ * SecureUniquePtr<T[]> and Buffer opt in by passing resource(). Buffers on the heap never use their inline storage,
+ * copies keep the source's resource unless another one is passed.
+ */
+class SecureHeap {
+public:
+    /**
+     * Size of the regions small blocks are carved from, in bytes.
+     */
+    static constexpr size_t REGION_SIZE = 256 * 1024;
+    /**
+     * Largest block in bytes carved out of a region, larger blocks get their own mapping.
+     */
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * Allocates a block of locked memory. Its contents are unspecified.
+     *
+     * @param size Size in bytes
+     * @param alignment Alignment in bytes, a power of two of at most the page size
+     * @return Pointer to the block
+     * @throws std::bad_alloc if no locked memory is available or the alignment is not supported
+     */
+    static void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    /**
+     * Shreds a block and returns it to the heap.
+     *
+     * @param data Pointer returned by allocate, may be nullptr
+     * @param size Size passed to allocate
+     * @param alignment Alignment passed to allocate
+     * @param strategy Contents written over the block
+     * @param dirty Leading bytes of the block that may hold data, only these are shredded
+     */
+    static void deallocate(void *data, size_t size, size_t alignment = alignof(std::max_align_t),
+                           ShredStrategy strategy = MemoryShredder::DEFAULT_STRATEGY, size_t dirty = SIZE_MAX);
+
+    /**
+     * @return Current statistics
+     */
+    static SecureHeapStats stats();
+
+    /**
+     * Memory resource allocating from the heap, for use with SecureUniquePtr<T[]>, Buffer and std::pmr containers.
+     *
+     * @return Pointer to the resource, which lives until program exit
+     */
+    static std::pmr::memory_resource *resource();
+};
+
+#endif //SECUREMEMORY_SECUREHEAP_H
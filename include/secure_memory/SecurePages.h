@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SECUREPAGES_H
+#define SECUREMEMORY_SECUREPAGES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <secure_memory/MemoryShredder.h>
+
+/**
+ * Page allocator for large secure blocks, backed by anonymous memory mappings. Blocks can grow by remapping their
+ * pages (mremap on Linux), which neither copies the data nor leaves a stale copy behind that would need shredding.
+ *
+ * Buffers with the default allocation use it for heap storage of at least MIN_SIZE bytes.
+ */
+class SecurePages {
+public:
+    /**
+     * Size in bytes from which Buffers with the default allocation use page backed storage.
+     */
+    static constexpr size_t MIN_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * Maps a block of zeroed pages.
+     *
+     * @param size Size in bytes, rounded up to whole pages
+     * @return Pointer to the block
+     * @throws std::bad_alloc if the mapping fails
+     */
+    static void *allocate(size_t size);
+    /**
+     * Shreds and unmaps a block, large blocks are shredded by discarding their pages (MemoryShredder::discard). Blocks
+     * above SecurePool::MAX_BLOCK_SIZE are handed to the BackgroundShredder if it is enabled.
+     *
+     * @param data Pointer returned by allocate or reallocate, may be nullptr
+     * @param size Current size of the block
+     * @param strategy Contents written over the block
+     * @param dirty Leading bytes of the block that may hold data, only these are shredded
+     */
+    static void deallocate(void *data, size_t size, ShredStrategy strategy = MemoryShredder::DEFAULT_STRATEGY,
+                           size_t dirty = SIZE_MAX);
+    /**
+     * Resizes a block by remapping its pages, moving them to a new address if necessary. The contents are kept,
+     * new pages are zeroed.
+     *
+     * @param data Pointer returned by allocate or reallocate
+     * @param size Current size of the block
+     * @param newSize New size in bytes
+     * @return Pointer to the resized block, which replaces data. nullptr if remapping is not supported or fails,
+     * then data remains valid.
+     */
+    static void *reallocate(void *data, size_t size, size_t newSize);
+
+    /**
+     * @return Number of blocks mapped by allocate(..) or resized by reallocate(..) since program start
+     */
+    static uint64_t allocations();
+
+    /**
+     * Memory resource allocating whole pages, for use with SecureUniquePtr<T[]>. Blocks are shredded on
+     * deallocation. Alignments are supported up to the page size.
+     *
+     * @return Pointer to the resource, which lives until program exit
+     */
+    static std::pmr::memory_resource *resource();
+};
+
+#endif //SECUREMEMORY_SECUREPAGES_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SECUREPOOL_H
+#define SECUREMEMORY_SECUREPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <secure_memory/MemoryShredder.h>
+
+/**
+ * Statistics of the calling thread's SecurePool cache.
+ */
+struct SecurePoolStats {
+    // allocations served from the cache
+    uint64_t hits = 0;
+    // allocations served by the system allocator
+    uint64_t misses = 0;
+    // blocks returned to the system allocator, because they are too large or the cache is full
+    uint64_t releases = 0;
+    // bytes currently held by the cache
+    size_t retained = 0;
+};
+
+/**
+ * Size-class pool for secure memory blocks, with one cache per thread. Freed blocks are shredded and kept for reuse
+ * by the freeing thread, so repeated allocations of similar sizes do not reach the system allocator. Block sizes are
+ * rounded up to powers of two between MIN_BLOCK_SIZE and MAX_BLOCK_SIZE, larger blocks are not cached.
+ *
+ * Used by SecureUniquePtr<T[]> for trivial types. Caching is disabled if built without SECURE_MEMORY_POOL, then
+ * blocks are shredded and freed immediately.
+ */
+class SecurePool {
+public:
+    /**
+     * Smallest size class in bytes.
+     */
+    static constexpr size_t MIN_BLOCK_SIZE = 16;
+    /**
+     * Largest size class in bytes, larger blocks bypass the cache.
+     */
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+    /**
+     * Default limit of bytes retained by each thread's cache.
+     */
+    static constexpr size_t DEFAULT_MAX_RETAINED = 1024 * 1024;
+
+    /**
+     * Allocates a block of at least size bytes, aligned like operator new. Its contents are unspecified.
+     *
+     * @param size Size in bytes
+     * @return Pointer to the block, nullptr if size is 0
+     */
+    static void *allocate(size_t size);
+    /**
+     * Shreds a block and returns it to the calling thread's cache, or to the system allocator if the block is too
+     * large or the cache is full. Blocks too large for the cache are handed to the BackgroundShredder if it is
+     * enabled.
+     *
+     * @param data Pointer returned by allocate, may be nullptr
+     * @param size Size passed to allocate
+     * @param strategy Contents written over the block
+     * @param dirty Leading bytes of the block that may hold data, only these are shredded
+     */
+    static void deallocate(void *data, size_t size, ShredStrategy strategy = MemoryShredder::DEFAULT_STRATEGY,
+                           size_t dirty = SIZE_MAX);
+
+    /**
+     * @return Statistics of the calling thread's cache
+     */
+    static const SecurePoolStats &stats();
+    /**
+     * Resets hit, miss and release counters of the calling thread's cache.
+     */
+    static void resetStats();
+
+    /**
+     * @return Limit of bytes retained by each thread's cache
+     */
+    static size_t maxRetained();
+    /**
+     * Sets the limit of bytes retained by each thread's cache. Caches exceeding it release freed blocks instead of
+     * retaining them, until allocations bring them below the limit.
+     *
+     * @param bytes New limit in bytes, 0 disables caching
+     */
+    static void maxRetained(size_t bytes);
+
+    /**
+     * Returns all blocks cached by the calling thread to the system allocator.
+     */
+    static void trim();
+
+    /**
+     * Memory resource allocating from the pool, for use with std::pmr containers. Blocks are shredded on
+     * deallocation. Alignments beyond alignof(std::max_align_t) bypass the cache.
+     *
+     * @return Pointer to the resource, which lives until program exit
+     */
+    static std::pmr::memory_resource *resource();
+};
+
+#endif //SECUREMEMORY_SECUREPOOL_H
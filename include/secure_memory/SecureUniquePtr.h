@@ -20,19 +20,17 @@
 #ifndef SECUREMEMORY_SECUREUNIQUEPTR_H
 #define SECUREMEMORY_SECUREUNIQUEPTR_H
 
+#include <algorithm>
 #include <memory>
 #include <iostream>
 #include <chrono>
+#include <cstddef>
+#include <type_traits>
 
-#include <secure_memory/SplitMix64.h>
-
-class MemoryShredder {
-public:
-    static void shred(void *data, size_t len);
-
-private:
-    static thread_local SplitMix64 sRng;
-};
+#include <secure_memory/MemoryShredder.h>
+#include <secure_memory/SecureHeap.h>
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SecurePool.h>
 
 /**
  * Wrapper around std::unique_ptr<T> which features secure memory erasing
@@ -79,6 +77,9 @@ public:
      * @param other
      */
     SecureUniquePtr<T> &operator=(SecureUniquePtr<T> &&other) noexcept {
+        // our memory is released, overwrite it first
+        if (this != &other)
+            MemoryShredder::shred(mPtr.get(), sizeof(T));
         mPtr = std::move(other.mPtr);
 
         return *this;
@@ -88,38 +89,182 @@ private:
     std::unique_ptr<T, std::default_delete<T>> mPtr;
 };
 
+/**
+ * Deleter of SecureUniquePtr<T[]>, which shreds the array before releasing it. Arrays are allocated from a
+ * std::pmr::memory_resource if one is given. Otherwise arrays of trivial types are allocated from and returned to the
+ * SecurePool, other types use new[] and delete[].
+ * The shred strategy is chosen per array and defaults to MemoryShredder::DEFAULT_STRATEGY. Only the leading dirty()
+ * elements are shredded, which are all elements unless the owner tracks its writes.
+ */
+template<typename T>
+class SecureArrayDeleter {
+public:
+    // whether arrays of T are allocated from the SecurePool by default
+    static constexpr bool POOLED = std::is_trivial<T>::value && alignof(T) <= alignof(std::max_align_t);
+
+    SecureArrayDeleter() noexcept = default;
+    /**
+     * @param size Number of elements of the array released by this deleter
+     * @param resource Memory resource the array was allocated from, nullptr for the default
+     * @param strategy Contents written over the array before it is released
+     */
+    explicit SecureArrayDeleter(size_t size, std::pmr::memory_resource *resource = nullptr,
+                                ShredStrategy strategy = MemoryShredder::DEFAULT_STRATEGY) noexcept
+            : mSize(size), mDirty(size), mResource(isDefault(resource) ? nullptr : resource), mStrategy(strategy) { }
+
+    /**
+     * Allocates an array to be released by a deleter of the same size and resource. Elements are
+     * default-initialized.
+     *
+     * @param size Number of elements
+     * @param resource Memory resource to allocate from, nullptr for the default
+     * @return Pointer to the array, nullptr if size is 0 and a resource is used
+     */
+    static T *allocate(size_t size, std::pmr::memory_resource *resource = nullptr) {
+        if (!isDefault(resource)) {
+            if (size == 0)
+                return nullptr;
+
+            T *ptr = static_cast<T *>(resource->allocate(sizeof(T) * size, alignof(T)));
+            try {
+                std::uninitialized_default_construct_n(ptr, size);
+            } catch (...) {
+                resource->deallocate(ptr, sizeof(T) * size, alignof(T));
+                throw;
+            }
+            return ptr;
+        }
+
+        if (POOLED)
+            return static_cast<T *>(SecurePool::allocate(sizeof(T) * size));
+        return new T[size];
+    }
+
+    /**
+     * Shreds and releases an array.
+     *
+     * @param ptr Pointer to the array
+     */
+    void operator()(T *ptr) const {
+        // the library's own allocators shred themselves, pass on what to shred
+        if (mResource == SecureHeap::resource()) {
+            std::destroy_n(ptr, mSize);
+            SecureHeap::deallocate(ptr, sizeof(T) * mSize, alignof(T), mStrategy, sizeof(T) * mDirty);
+        } else if (mResource == SecurePages::resource()) {
+            std::destroy_n(ptr, mSize);
+            SecurePages::deallocate(ptr, sizeof(T) * mSize, mStrategy, sizeof(T) * mDirty);
+        } else if (mResource != nullptr) {
+            std::destroy_n(ptr, mSize);
+            MemoryShredder::shred(ptr, sizeof(T) * mDirty, mStrategy);
+            mResource->deallocate(ptr, sizeof(T) * mSize, alignof(T));
+        } else if (POOLED) {
+            SecurePool::deallocate(ptr, sizeof(T) * mSize, mStrategy, sizeof(T) * mDirty);
+        } else {
+            MemoryShredder::shred(ptr, sizeof(T) * mDirty, mStrategy);
+            delete[] ptr;
+        }
+    }
+
+    /**
+     * @return Number of elements of the array released by this deleter
+     */
+    size_t size() const {
+        return mSize;
+    }
+
+    /**
+     * @return Number of leading elements that may hold data and are shredded on release
+     */
+    size_t dirty() const {
+        return mDirty;
+    }
+    /**
+     * @param elements Number of leading elements that may hold data, at most the size
+     */
+    void dirty(size_t elements) {
+        mDirty = std::min(elements, mSize);
+    }
+
+    /**
+     * @return Memory resource the array was allocated from, nullptr for the default
+     */
+    std::pmr::memory_resource *resource() const {
+        return mResource;
+    }
+
+    /**
+     * @return Contents written over the array before it is released
+     */
+    ShredStrategy strategy() const {
+        return mStrategy;
+    }
+    /**
+     * @param strategy Contents written over the array before it is released
+     */
+    void strategy(ShredStrategy strategy) {
+        mStrategy = strategy;
+    }
+
+private:
+    // the SecurePool's resource is equivalent to the default for pooled types
+    static bool isDefault(std::pmr::memory_resource *resource) {
+        return resource == nullptr || (POOLED && resource == SecurePool::resource());
+    }
+
+    size_t mSize = 0;
+    // leading elements that may hold data
+    size_t mDirty = 0;
+    std::pmr::memory_resource *mResource = nullptr;
+    ShredStrategy mStrategy = MemoryShredder::DEFAULT_STRATEGY;
+};
+
 /**
  * Wrapper around std::unique_ptr<T[]> which features secure memory erasing. This is the array version.
  */
 template<typename T>
 class SecureUniquePtr<T[]> {
 public:
+    using Deleter = SecureArrayDeleter<T>;
+
+    /**
+     * Creates an empty SecureUniquePtr<T[]> that does not own any memory.
+     */
+    SecureUniquePtr() noexcept = default;
+
     /**
      * Creates a std::unique_ptr<T[]> with size elements.
      * @param size
      */
-    explicit SecureUniquePtr(size_t size) : mPtr(new T[size]), mSize(size) { }
+    explicit SecureUniquePtr(size_t size) : mPtr(Deleter::allocate(size), Deleter(size)) { }
+    /**
+     * Creates a std::unique_ptr<T[]> with size elements allocated from a memory resource. The memory is shredded
+     * before it is returned to the resource.
+     *
+     * @param size Number of elements
+     * @param resource Memory resource, which must outlive the array. nullptr selects the default allocation.
+     */
+    SecureUniquePtr(size_t size, std::pmr::memory_resource *resource)
+            : mPtr(Deleter::allocate(size, resource), Deleter(size, resource)) { }
 
     /**
      * Transfers ownership of other's std::unique_ptr<T[]> to us
      * @param other
      */
-    SecureUniquePtr(SecureUniquePtr<T[]> && other) noexcept : mPtr(std::move(other.mPtr)), mSize(other.mSize) {
-        other.mSize = 0;
+    SecureUniquePtr(SecureUniquePtr<T[]> && other) noexcept : mPtr(std::move(other.mPtr)) {
+        other.mPtr.get_deleter() = Deleter();
     }
 
     /**
-     * Securely overwrite memory used by std::unique_ptr<T[]>
+     * Securely overwrite memory used by std::unique_ptr<T[]>, which is done by its deleter
      */
-    ~SecureUniquePtr() {
-        MemoryShredder::shred(mPtr.get(), sizeof(T) * mSize);
-    }
+    ~SecureUniquePtr() = default;
 
     /**
-     * Convenience method for getting internal std::unique_ptr<T[]>
+     * Convenience method for getting internal std::unique_ptr<T[]>. It cannot be modified, since its deleter
+     * releases memory to the allocator the array came from.
      * @return Internal std::unique_ptr<T[]>
      */
-    std::unique_ptr<T[], std::default_delete<T[]>> &operator()() {
+    const std::unique_ptr<T[], Deleter> &operator()() {
         return mPtr;
     }
 
@@ -127,7 +272,7 @@ public:
      * Convenience method for getting internal std::unique_ptr<T> (const)
      * @return Internal std::unique_ptr<T> (const)
      */
-    const std::unique_ptr<T[], std::default_delete<T[]>> &operator()() const {
+    const std::unique_ptr<T[], Deleter> &operator()() const {
         return mPtr;
     }
 
@@ -136,10 +281,11 @@ public:
      * @param other
      */
     SecureUniquePtr<T[]> &operator=(SecureUniquePtr<T[]> &&other) noexcept {
-        mPtr = std::move(other.mPtr);
-        mSize = other.mSize;
-
-        other.mSize = 0;
+        if (this != &other) {
+            // our memory is shredded and released by the deleter
+            mPtr = std::move(other.mPtr);
+            other.mPtr.get_deleter() = Deleter();
+        }
         return *this;
     }
 
@@ -147,12 +293,53 @@ public:
      * Getter: array's number of elements
      */
     size_t size() const {
-        return mSize;
+        return mPtr.get_deleter().size();
+    }
+
+    /**
+     * Getter: number of leading elements that may hold data, only these are shredded. Defaults to the size.
+     */
+    size_t dirty() const {
+        return mPtr.get_deleter().dirty();
+    }
+    /**
+     * Setter: number of leading elements that may hold data, only these are shredded. Owners that track their
+     * writes can lower it to skip untouched or already shredded memory.
+     */
+    void dirty(size_t elements) {
+        mPtr.get_deleter().dirty(elements);
+    }
+
+    /**
+     * Getter: memory resource of the array, nullptr for the default allocation
+     */
+    std::pmr::memory_resource *resource() const {
+        return mPtr.get_deleter().resource();
+    }
+
+    /**
+     * Getter: contents written over the array before it is released
+     */
+    ShredStrategy shredStrategy() const {
+        return mPtr.get_deleter().strategy();
+    }
+    /**
+     * Setter: contents written over the array before it is released
+     */
+    void shredStrategy(ShredStrategy strategy) {
+        mPtr.get_deleter().strategy(strategy);
     }
 
 private:
-    std::unique_ptr<T[], std::default_delete<T[]>> mPtr;
-    size_t mSize;
+    // Buffer manages the deleter of unallocated storage and adopts remapped pages
+    template<typename SizeT>
+    friend class BasicBuffer;
+
+    std::unique_ptr<T[], Deleter> &ptr() {
+        return mPtr;
+    }
+
+    std::unique_ptr<T[], Deleter> mPtr;
 };
 
 #endif //SECUREMEMORY_SECUREUNIQUEPTR_H
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SHAREDBUFFER_H
+#define SECUREMEMORY_SHAREDBUFFER_H
+
+#include <memory>
+
+#include "Buffer.h"
+#include "BufferRange.h"
+#include "BufferView.h"
+
+/**
+ * Immutable, reference-counted Buffer. Copies and slices share the data instead of copying it, the data is shredded
+ * when the last reference is dropped. Reference counting is atomic, so copies may be passed to other threads.
+ * Converts to BufferRangeConst for existing readers.
+ */
+class SharedBuffer {
+public:
+    /**
+     * Creates an empty SharedBuffer without data.
+     */
+    SharedBuffer() = default;
+    /**
+     * Creates a SharedBuffer taking over a Buffer's data, without copying heap storage.
+     *
+     * @param buffer Buffer to move from
+     */
+    explicit SharedBuffer(Buffer &&buffer);
+    /**
+     * Creates a SharedBuffer from a copy of a range.
+     *
+     * @param range Data to copy
+     */
+    explicit SharedBuffer(const BufferRangeConst &range);
+
+    /**
+     * Creates a slice of this SharedBuffer, which shares its data. Offset and size are limited to this slice.
+     *
+     * @param offset Offset of the slice relative to this slice
+     * @param size Size of the slice
+     * @return New slice
+     */
+    SharedBuffer slice(uint32_t offset, uint32_t size = UINT32_MAX) const;
+
+    /**
+     * @return Size of this slice in bytes
+     */
+    inline uint32_t size() const {
+        return mSize;
+    }
+    /**
+     * @return True if this slice is empty
+     */
+    inline bool empty() const {
+        return mSize == 0;
+    }
+    /**
+     * @return Number of SharedBuffers referencing the data, 0 if there is none
+     */
+    inline long useCount() const {
+        return mBuffer.use_count();
+    }
+
+    /**
+     * Returns a constant data pointer to the slice's data at offset p, nullptr if there is no data.
+     *
+     * @param p Offset into the slice, limited to its size. Defaults to 0.
+     */
+    const void *const_data_raw(uint32_t p = 0) const;
+    /**
+     * Returns a typed constant data pointer to the slice's data at offset p, nullptr if there is no data.
+     *
+     * @tparam T Type of data pointed to by result.
+     * @param p Offset into the slice, limited to its size. Defaults to 0.
+     * @return Typed pointer into the slice.
+     */
+    template<typename T = uint8_t>
+    const T *const_data(uint32_t p = 0) const {
+        return static_cast<const T *>(const_data_raw(p));
+    }
+    /**
+     * Creates a Range within this slice, which is valid as long as this SharedBuffer references the data.
+     *
+     * @param offset Offset relative to this slice, limited to its size
+     * @param size Size of the Range, limited to this slice
+     * @return Range of the underlying Buffer
+     */
+    BufferRangeConst const_data(uint32_t offset, uint32_t size) const;
+
+    /**
+     * @return View of this slice
+     */
+    inline BufferView view() const {
+        return {const_data(), mSize};
+    }
+    /**
+     * @return Range of this slice, which is valid as long as this SharedBuffer references the data
+     */
+    inline operator BufferRangeConst() const { // NOLINT(google-explicit-constructor)
+        return const_data(0, mSize);
+    }
+
+    /**
+     * @return Mutable copy of this slice
+     */
+    Buffer toBuffer() const &;
+    /**
+     * Converts this slice into a mutable Buffer, copy-on-write: if this is the only reference to the data, the
+     * underlying Buffer is taken over without copying. This SharedBuffer is left empty. Safe while other threads
+     * release their references to the data concurrently, but not while they copy this SharedBuffer.
+     *
+     * @return Buffer holding this slice's data
+     */
+    Buffer toBuffer() &&;
+
+    /**
+     * Compares the contents of two SharedBuffers
+     *
+     * @param other SharedBuffer to compare with
+     * @return True if their sizes and contents are equal
+     */
+    bool operator==(const SharedBuffer &other) const;
+    /**
+     * Compares the contents of two SharedBuffers
+     *
+     * @param other SharedBuffer to compare with
+     * @return True if their sizes or contents differ
+     */
+    inline bool operator!=(const SharedBuffer &other) const {
+        return !operator==(other);
+    }
+
+private:
+    SharedBuffer(std::shared_ptr<Buffer> buffer, uint32_t offset, uint32_t size);
+
+    // shared data, never modified while shared
+    std::shared_ptr<Buffer> mBuffer;
+    // slice within the shared data
+    uint32_t mOffset = 0, mSize = 0;
+};
+
+#endif //SECUREMEMORY_SHAREDBUFFER_H
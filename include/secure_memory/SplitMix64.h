@@ -55,17 +55,18 @@ public:
      * @param data Buffer pointer
      * @param size Size of buffer
      */
-    void nextBytes(uint8_t *data, uint32_t size) {
-        uint32_t nblocks = size / sizeof(result_type), nbytes = size % sizeof(result_type);
-        auto *out = reinterpret_cast<result_type *>(data);
+    void nextBytes(uint8_t *data, size_t size) {
+        size_t nblocks = size / sizeof(result_type), nbytes = size % sizeof(result_type);
 
-        // fill T blocks
-        for (uint32_t i = 0; i < nblocks; i++)
-            out[i] = next();
+        // fill T blocks, data may be unaligned (e.g. memory from a std::pmr::memory_resource)
+        for (size_t i = 0; i < nblocks; i++) {
+            auto val = next();
+            std::memcpy(data + i * sizeof(result_type), &val, sizeof(result_type));
+        }
 
         // fill remaining bytes
         auto val = next();
-        std::memcpy(out + nblocks, &val, nbytes);
+        std::memcpy(data + nblocks * sizeof(result_type), &val, nbytes);
     }
 
     static constexpr result_type min() { return std::numeric_limits<result_type>::lowest(); }
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SPLITMIX64X8_H
+#define SECUREMEMORY_SPLITMIX64X8_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Instruction sets the lanes of SplitMix64x8 can be advanced with.
+ */
+enum class SplitMix64Isa : uint8_t {
+    /// Eight independent scalar states, interleaved by the CPU
+    Scalar,
+    /// Two 256 bit registers, 64 bit multiplies are composed of 32 bit ones
+    AVX2,
+    /// One 512 bit register with native 64 bit multiplies (AVX-512F and AVX-512DQ)
+    AVX512,
+};
+
+/**
+ * Eight independent SplitMix64 generators advanced in lockstep, for filling large buffers with random bytes. A single
+ * SplitMix64 produces one word per chain of dependent multiplies, the lanes hide that latency and are advanced in SIMD
+ * registers where available. Each iteration produces one 64 byte block, word i of each block is the next output of
+ * lane i. The output is the same with every instruction set.
+ *
+ * Not cryptographically secure.
+ */
+class SplitMix64x8 {
+public:
+    /**
+     * Number of independent generators.
+     */
+    static constexpr size_t LANES = 8;
+    /**
+     * Bytes produced per iteration, one word of each lane.
+     */
+    static constexpr size_t BLOCK_SIZE = LANES * sizeof(uint64_t);
+
+    /**
+     * Seeds the lanes with consecutive outputs of SplitMix64(seed).
+     *
+     * @param seed Seed of all lanes
+     */
+    explicit SplitMix64x8(uint64_t seed = 0);
+
+    /**
+     * Fills given buffer with random bytes. A partial block at the end consumes a whole one.
+     *
+     * @param data Buffer pointer, may be unaligned
+     * @param size Size of buffer
+     */
+    void nextBytes(uint8_t *data, size_t size);
+
+    /**
+     * @return Instruction set used by all generators
+     */
+    static SplitMix64Isa isa();
+    /**
+     * Selects the instruction set used by all generators, e.g. for benchmarks. Defaults to the best one the CPU
+     * supports.
+     *
+     * @param isa Instruction set, limited to the best one the CPU supports
+     */
+    static void isa(SplitMix64Isa isa);
+    /**
+     * @return Best instruction set the CPU supports
+     */
+    static SplitMix64Isa supportedIsa();
+
+protected:
+    // states of the lanes
+    uint64_t mState[LANES];
+};
+
+#endif //SECUREMEMORY_SPLITMIX64X8_H
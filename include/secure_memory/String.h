@@ -39,12 +39,22 @@ public:
      */
     String(const char *c_str); // NOLINT(google-explicit-constructor)
     /**
-     * Creates a String object from another String, copying it's contents
+     * Creates a String object from a c-style string, copying it's contents into memory allocated from a memory
+     * resource.
+     *
+     * Warning: The string must be 0-terminated!
+     * @param c_str C-style string
+     * @param resource Memory resource for all heap allocations of this String, which must outlive it. nullptr selects
+     * the default allocation.
+     */
+    String(const char *c_str, std::pmr::memory_resource *resource);
+    /**
+     * Creates a String object from another String, copying it's contents into memory of the same resource
      * @param other The other String object
      */
     String(const String &other);
     /**
-     * Creates a String object from a Buffer, copying it's contents
+     * Creates a String object from a Buffer, copying it's contents into memory of the same resource
      * @param other The other Buffer object
      */
     String(const Buffer &other); // NOLINT(google-explicit-constructor)
@@ -180,11 +190,11 @@ public:
      * @return param is (for chaining)
      */
     friend std::istream &operator>>(std::istream &is, String &string) {
-        string.increase(sizeof(char) * 512);
-        is.getline(string.data<char>(), sizeof(char) * 512);
+        MutableBufferView line = string.prepare(sizeof(char) * 512);
+        is.getline(reinterpret_cast<char *>(line.data()), static_cast<std::streamsize>(line.size()));
 
         // we don't want the istream 0-terminator
-        string.use(static_cast<uint32_t>(is.gcount() > 0 ? is.gcount() - 1 : 0u));
+        string.commit(static_cast<uint32_t>(is.gcount() > 0 ? is.gcount() - 1 : 0u));
         return is;
     }
 
@@ -214,6 +224,9 @@ public:
     using Buffer::serialize;
 
 protected:
+    // initial capacity of mCStrings
+    static constexpr uint32_t C_STRINGS_RESERVED = 512;
+
     Buffer mCStrings;
 
 private:
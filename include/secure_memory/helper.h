@@ -23,8 +23,9 @@
 #include <cstring>
 #include <functional>
 #include "conversions.h"
+#include "SafeInt.h"
 
-inline bool comparisonHelper(const void *a, const void *b, uint32_t size) {
+inline bool comparisonHelper(const void *a, const void *b, size_t size) {
     auto *c1 = static_cast<const char *>(a), *c2 = static_cast<const char *>(b);
 
     // loop breaks on different character or if size() elements have been checked
@@ -34,11 +35,11 @@ inline bool comparisonHelper(const void *a, const void *b, uint32_t size) {
     return size == 0;
 }
 
-inline bool lessHelper(const void *a, uint32_t sizeA, const void *b, uint32_t sizeB) {
+inline bool lessHelper(const void *a, size_t sizeA, const void *b, size_t sizeB) {
     auto *u1 = static_cast<const uint8_t *>(a), *u2 = static_cast<const uint8_t *>(b);
 
     // loop breaks on different character or if sizeA or sizeB has been checked
-    uint32_t i = 0;
+    size_t i = 0;
     for(; i < sizeA && i < sizeB && u1[i] == u2[i]; i++);
 
     // if both sizes still fit, unequal byte was encountered, use operator<
@@ -49,6 +50,16 @@ inline bool lessHelper(const void *a, uint32_t sizeA, const void *b, uint32_t si
     return sizeA < sizeB;
 }
 
+// taken from https://stackoverflow.com/questions/2590677/how-do-i-combine-hash-values-in-c0x
+SM_NO_SANITIZE inline size_t hashHelper(const void *data, size_t size) {
+    auto *u = static_cast<const uint8_t *>(data);
+
+    size_t current = 0;
+    for (size_t i = 0; i < size; i++)
+        current ^= u[i] + 0x9e3779b9UL + (current << 6u) + (current >> 2u);
+    return current;
+}
+
 inline size_t strlen_s(const char *str) {
     if (str == nullptr)
         return 0;
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include <secure_memory/BackgroundShredder.h>
+
+/**
+ * Shared state of the background thread and releasing threads.
+ */
+struct ShredQueue {
+    struct Block {
+        void *data;
+        size_t size, dirty;
+        ShredStrategy strategy;
+        BackgroundShredder::Release release;
+    };
+
+    void run();
+
+    // serializes starting and stopping the worker
+    std::mutex control;
+    std::mutex mutex;
+    // signals the worker that blocks are queued or it should stop
+    std::condition_variable work;
+    // signals releasing and flushing threads that blocks are done
+    std::condition_variable done;
+    std::deque<Block> blocks;
+    std::thread worker;
+    // whether defer queues blocks, whether the worker should exit once the queue is empty
+    bool enabled = false, stopping = false;
+    // whether the worker is shredding a block outside the lock
+    bool busy = false;
+    // whether program exit stops the worker
+    bool exitHandler = false;
+    size_t maxQueued = BackgroundShredder::DEFAULT_MAX_QUEUED;
+    size_t maxPending = BackgroundShredder::DEFAULT_MAX_PENDING;
+    BackgroundShredderStats stats;
+};
+
+// never destroyed, so releases during program exit remain safe
+static ShredQueue &queue() {
+    static auto *queue = new ShredQueue();
+    return *queue;
+}
+
+void ShredQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        work.wait(lock, [this] { return stopping || !blocks.empty(); });
+        if (blocks.empty())
+            break;
+
+        Block block = blocks.front();
+        blocks.pop_front();
+        busy = true;
+        done.notify_all();
+
+        lock.unlock();
+        if (block.release != nullptr) {
+            block.release(block.data, block.size, block.strategy, block.dirty);
+        } else {
+            MemoryShredder::shred(block.data, block.dirty, block.strategy);
+            ::operator delete(block.data);
+        }
+        lock.lock();
+
+        stats.pending -= block.size;
+        busy = false;
+        done.notify_all();
+    }
+}
+
+bool BackgroundShredder::enabled() {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    return queue().enabled;
+}
+
+void BackgroundShredder::enabled(bool enable) {
+    ShredQueue &q = queue();
+    std::lock_guard<std::mutex> control(q.control);
+    std::unique_lock<std::mutex> lock(q.mutex);
+    if (enable == q.enabled)
+        return;
+
+    if (enable) {
+        q.stopping = false;
+        q.worker = std::thread(&ShredQueue::run, &q);
+        q.enabled = true;
+
+        // queued blocks must not outlive the process unshredded
+        if (!q.exitHandler) {
+            q.exitHandler = true;
+            std::atexit([] { BackgroundShredder::enabled(false); });
+        }
+    } else {
+        // the worker drains the queue before it exits, waiting releases fall back to synchronous shredding
+        q.enabled = false;
+        q.stopping = true;
+        q.work.notify_one();
+        q.done.notify_all();
+
+        std::thread worker = std::move(q.worker);
+        lock.unlock();
+        worker.join();
+    }
+}
+
+bool BackgroundShredder::defer(void *data, size_t size, ShredStrategy strategy, size_t dirty, Release release) {
+    ShredQueue &q = queue();
+    std::unique_lock<std::mutex> lock(q.mutex);
+    if (!q.enabled)
+        return false;
+
+    auto overBudget = [&q, size] { return size > q.maxPending || q.stats.pending > q.maxPending - size; };
+    if (overBudget()) {
+        q.stats.synchronous++;
+        return false;
+    }
+
+    // backpressure: wait for the worker instead of growing the queue
+    if (q.blocks.size() >= q.maxQueued) {
+        q.stats.stalls++;
+        q.done.wait(lock, [&q] { return !q.enabled || q.blocks.size() < q.maxQueued; });
+        if (!q.enabled)
+            return false;
+
+        // other threads may have queued blocks meanwhile
+        if (overBudget()) {
+            q.stats.synchronous++;
+            return false;
+        }
+    }
+
+    try {
+        q.blocks.push_back({data, size, std::min(dirty, size), strategy, release});
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+
+    q.stats.pending += size;
+    q.stats.deferred++;
+    q.work.notify_one();
+    return true;
+}
+
+void BackgroundShredder::flush() {
+    ShredQueue &q = queue();
+    std::unique_lock<std::mutex> lock(q.mutex);
+    q.done.wait(lock, [&q] { return q.blocks.empty() && !q.busy; });
+}
+
+size_t BackgroundShredder::maxQueued() {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    return queue().maxQueued;
+}
+
+void BackgroundShredder::maxQueued(size_t blocks) {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    queue().maxQueued = std::max<size_t>(blocks, 1);
+    queue().done.notify_all();
+}
+
+size_t BackgroundShredder::maxPending() {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    return queue().maxPending;
+}
+
+void BackgroundShredder::maxPending(size_t bytes) {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    queue().maxPending = bytes;
+}
+
+BackgroundShredderStats BackgroundShredder::stats() {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    return queue().stats;
+}
+
+void BackgroundShredder::resetStats() {
+    std::lock_guard<std::mutex> lock(queue().mutex);
+    size_t pending = queue().stats.pending;
+    queue().stats = {};
+    queue().stats.pending = pending;
+}
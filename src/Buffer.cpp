@@ -17,80 +17,153 @@
  * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifndef _WIN32
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+
 #include <secure_memory/Buffer.h>
 #include <secure_memory/BufferRange.h>
+#include "PageSize.h"
+
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer() : BasicBuffer(0) { }
 
-Buffer::Buffer() : Buffer(512) { }
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(SizeT reserved, std::pmr::memory_resource *resource) {
+    // empty buffers defer allocation until the first write, small buffers use the inline storage
+    mData.ptr().get_deleter() = Deleter(reserved, resource);
+    if (reserved > inlineSize())
+        mData = SecureUniquePtr<uint8_t[]>(reserved, allocationResource(reserved));
+    mData.dirty(0);
+}
 
-Buffer::Buffer(uint32_t reserved) : mData(reserved), mReserved(reserved) { }
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(const void *bytes, SizeT size) : BasicBuffer(size) {
+    BasicBuffer::append(bytes, size);
+}
 
-Buffer::Buffer(const void *bytes, uint32_t size) : Buffer(size) {
-    Buffer::append(bytes, size);
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(SecureUniquePtr<uint8_t[]> &&data, SizeT used) : mData(std::move(data)) {
+    mUsed = std::min<SizeT>(used, reserved());
 }
 
-Buffer::Buffer(const BufferRangeConst &range) : Buffer(range.size()) {
-    Buffer::append(range);
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(const BufferRangeConst &range) : BasicBuffer(range.size()) {
+    BasicBuffer::append(range);
 }
 
-Buffer::Buffer(const std::string &stl_str) : Buffer(stl_str.size()) {
-    Buffer::append(stl_str.data(), stl_str.size());
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(BufferView view)
+        : BasicBuffer(static_cast<SizeT>(std::min<uint64_t>(view.size(), std::numeric_limits<SizeT>::max()))) {
+    BasicBuffer::append(view);
 }
 
-Buffer::Buffer(const Buffer &buffer)
-        : mData(buffer.mReserved), mReserved(buffer.mReserved), mOffset(0), mUsed(buffer.mUsed) {
-    // copy whole old buffer into new one. But drop the already skipped bytes (mOffset)
-    memcpy(mData().get(), &buffer.mData()[buffer.mOffset], mUsed);
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(const std::string &stl_str) : BasicBuffer(stl_str.size()) {
+    BasicBuffer::append(stl_str.data(), stl_str.size());
 }
 
-Buffer::Buffer(Buffer &&buffer) noexcept
-        : mData(std::move(buffer.mData)), mReserved(buffer.mReserved), mOffset(buffer.mOffset), mUsed(buffer.mUsed) {
-    buffer.mReserved = 0;
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(const BasicBuffer &buffer) : BasicBuffer(buffer, buffer.resource()) { }
+
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(const BasicBuffer &buffer, std::pmr::memory_resource *resource)
+        : BasicBuffer(make_si<SizeT>(buffer.mUsed) + make_si<SizeT>(buffer.mPolicy.copySlack), resource) {
+    mUsed = buffer.mUsed;
+    mPolicy = buffer.mPolicy;
+    shredStrategy(buffer.shredStrategy());
+
+    // copy whole old buffer into new one. But drop the already skipped bytes (mOffset)
+    if (mUsed != 0)
+        memcpy(storage(), buffer.storage() + buffer.mOffset, mUsed);
+    mData.dirty(mUsed);
+}
+
+template<typename SizeT>
+BasicBuffer<SizeT>::BasicBuffer(BasicBuffer &&buffer) noexcept
+        : mData(std::move(buffer.mData)), mOffset(buffer.mOffset), mUsed(buffer.mUsed), mPolicy(buffer.mPolicy) {
+#ifdef SECURE_MEMORY_BUFFER_STATS
+    mStats = buffer.mStats;
+    buffer.mStats = {};
+#endif
+
+    // inline storage cannot be moved, copy it and shred the original
+    if (isInline()) {
+        memcpy(mInline, buffer.mInline, mData.dirty());
+        MemoryShredder::shred(buffer.mInline, mData.dirty(), shredStrategy());
+    }
+
+    // leave other in unallocated default state, keeping resource and strategy
+    buffer.mData.ptr().get_deleter() = Deleter(0, resource(), shredStrategy());
     buffer.mOffset = 0;
     buffer.mUsed = 0;
 }
 
-Buffer::~Buffer() = default;
+template<typename SizeT>
+BasicBuffer<SizeT>::~BasicBuffer() {
+    // heap storage is shredded by SecureUniquePtr
+    if (isInline())
+        MemoryShredder::shred(mInline, mData.dirty(), shredStrategy());
+}
 
-BufferRangeConst Buffer::append(const void *data, uint32_t len) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::append(const void *data, SizeT len) -> BufferRangeConst {
     return write(data, len, mUsed);
 }
 
-BufferRangeConst Buffer::append(const Buffer &other) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::append(const BasicBuffer &other) -> BufferRangeConst {
     return append(other.const_data(), other.size());
 }
 
-BufferRangeConst Buffer::append(const BufferRangeConst &range) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::append(BufferView view) -> BufferRangeConst {
+    return append(view.data(), static_cast<SizeT>(std::min<uint64_t>(view.size(), std::numeric_limits<SizeT>::max())));
+}
+
+template<typename SizeT>
+auto BasicBuffer<SizeT>::append(const BufferRangeConst &range) -> BufferRangeConst {
     return append(range.const_data(), range.size());
 }
 
-BufferRangeConst Buffer::write(const void *data, uint32_t len, uint32_t offset) {
-    auto requested = mOffset + make_si(offset) + make_si(len);
-    if (requested > mReserved)
-        increase(requested + mReserved * 2_si32);
+template<typename SizeT>
+auto BasicBuffer<SizeT>::write(const void *data, SizeT len, SizeT offset) -> BufferRangeConst {
+    ensureCapacity(make_si(offset) + make_si(len));
 
     // now copy new data (if not nullptr)
-    if (data != nullptr)
-        memcpy(&mData()[mOffset + make_si(offset)], data, len);
+    if (data != nullptr && len != 0)
+        memcpy(storage() + (mOffset + make_si(offset)), data, len);
 
     if (make_si(offset) + make_si(len) > mUsed)
         mUsed = make_si(offset) + make_si(len);
+    markDirty(mOffset + make_si(offset) + make_si(len));
 
     return {*this, offset, len};
 }
 
-BufferRangeConst Buffer::write(const Buffer &other, uint32_t offset) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::write(const BasicBuffer &other, SizeT offset) -> BufferRangeConst {
     return write(other.const_data(), other.size(), offset);
 }
 
-BufferRangeConst Buffer::write(const BufferRange &other, uint32_t offset) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::write(const BufferRange &other, SizeT offset) -> BufferRangeConst {
     return write(other.const_data(), other.size(), offset);
 }
 
-BufferRangeConst Buffer::write(const BufferRangeConst &other, uint32_t offset) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::write(const BufferRangeConst &other, SizeT offset) -> BufferRangeConst {
     return write(other.const_data(), other.size(), offset);
 }
 
-void Buffer::consume(uint32_t n) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::consume(SizeT n) {
     if (n > mUsed)
         n = mUsed;
 
@@ -98,7 +171,8 @@ void Buffer::consume(uint32_t n) {
     mUsed -= make_si(n);
 }
 
-void Buffer::unconsume(uint32_t offsetDiff) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::unconsume(SizeT offsetDiff) {
     if (offsetDiff > mOffset)
         offsetDiff = 0;
 
@@ -106,53 +180,161 @@ void Buffer::unconsume(uint32_t offsetDiff) {
     mOffset -= make_si(offsetDiff);
 }
 
-void Buffer::use(uint32_t n) {
-    if ((mReserved - mOffset) >= make_si(n) + mUsed)
+template<typename SizeT>
+void BasicBuffer<SizeT>::use(SizeT n) {
+    if ((reserved() - mOffset) >= make_si(n) + mUsed)
         mUsed += make_si(n);
     else
-        mUsed = mReserved - mOffset;
+        mUsed = reserved() - mOffset;
+    markDirty(mOffset + mUsed);
 }
 
-void Buffer::unuse(uint32_t n) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::unuse(SizeT n) {
     if (n > mUsed)
         n = mUsed;
 
     mUsed -= make_si(n);
 }
 
-uint32_t Buffer::increase(const uint32_t newCapacity, const bool by) {
+template<typename SizeT>
+MutableBufferView BasicBuffer<SizeT>::prepare(SizeT n) {
+    ensureCapacity(mUsed + make_si(n));
+
+    // the capacity saturates at the maximum size. The caller writes to the returned bytes, even if it never commits.
+    SizeT len = std::min<SizeT>(n, capacity() - mUsed);
+    markDirty(mOffset + mUsed + make_si(len));
+    return {storage() + (mOffset + mUsed), len};
+}
+
+template<typename SizeT>
+SizeT BasicBuffer<SizeT>::increase(const SizeT newCapacity, const bool by) {
     auto capa = make_si(newCapacity);
     if (by)
         capa += mUsed;
 
     // no need to increase, since buffer is as big as requested
-    if (capa <= mReserved - mOffset)
-        return mReserved - mOffset;
+    if (capa <= reserved() - mOffset)
+        return reserved() - mOffset;
+
+    // buffer is big enough after dropping the consumed bytes
+    if (compact(capa))
+        return reserved();
+
+    // small enough for inline storage: move used bytes to the front instead of allocating
+    if (capa <= inlineSize() && !mData()) {
+        if (isInline())
+            memmove(mInline, mInline + mOffset, mUsed);
+
+        resetStorage(capa, static_cast<SizeT>(mData.dirty()));
+        mOffset = 0;
+        return capa;
+    }
+
+    // page backed storage grows by remapping, without copying or leaving a stale copy behind
+    if (mData() && mData.resource() == SecurePages::resource() && remap(capa))
+        return reserved() - mOffset;
 
     // reallocate
-    mReserved = capa;
-    SecureUniquePtr<uint8_t[]> newData(mReserved);
+    SecureUniquePtr<uint8_t[]> newData(capa, allocationResource(capa));
+    newData.shredStrategy(shredStrategy());
 
     // copy whole old buffer into new one. But drop the already skipped bytes (mOffset)
-    memcpy(newData().get(), &mData()[mOffset], mUsed);
+    if (mUsed != 0)
+        memcpy(newData().get(), storage() + mOffset, mUsed);
+
+    // first allocation of an empty Buffer is not a reallocation
+    if (storage() != nullptr)
+        countReallocation(mUsed);
+
+    // heap storage is shredded by SecureUniquePtr, inline storage must be shredded here
+    if (isInline())
+        MemoryShredder::shred(mInline, mData.dirty(), shredStrategy());
 
     mData = std::move(newData);
+    mData.dirty(mUsed);
     mOffset = 0;
 
-    return mReserved;
+    return capa;
 }
 
-uint32_t Buffer::increase(const uint32_t newCapacity, const uint8_t value, const bool by) {
-    uint32_t r = increase(newCapacity, by);
+template<typename SizeT>
+SizeT BasicBuffer<SizeT>::increase(const SizeT newCapacity, const uint8_t value, const bool by) {
+    SizeT r = increase(newCapacity, by);
 
     // initialize with supplied value
-    for (uint32_t i = mUsed; i < r; ++i)
-        data()[i] = value;
+    if (mUsed < r) {
+        markDirty(mOffset + make_si(r));
+        memset(storage() + (mOffset + mUsed), value, r - mUsed);
+    }
 
     return r;
 }
 
-void Buffer::padd(const uint32_t offset, const uint32_t size, const uint8_t value) {
+template<typename SizeT>
+SecureUniquePtr<uint8_t[]> BasicBuffer<SizeT>::release() {
+    SecureUniquePtr<uint8_t[]> result;
+    std::pmr::memory_resource *resource = this->resource();
+    ShredStrategy strategy = shredStrategy();
+
+    if (mData()) {
+        if (mOffset != 0u && mUsed != 0u)
+            memmove(mData().get(), mData().get() + mOffset, mUsed);
+        result = std::move(mData);
+    } else if (mUsed != 0u) {
+        // inline storage cannot be handed out
+        result = SecureUniquePtr<uint8_t[]>(mUsed, resource);
+        result.shredStrategy(strategy);
+        memcpy(result().get(), mInline + mOffset, mUsed);
+    }
+
+    if (isInline())
+        MemoryShredder::shred(mInline, mData.dirty(), strategy);
+
+    // leave this in unallocated default state, keeping resource and strategy
+    mData.ptr().get_deleter() = Deleter(0, resource, strategy);
+    mOffset = 0;
+    mUsed = 0;
+    return result;
+}
+
+template<typename SizeT>
+void BasicBuffer<SizeT>::shrink_to_fit() {
+    // inline storage has no memory to release
+    if (!mData() || (mOffset == 0u && capacity() == mUsed))
+        return;
+
+    // old heap storage is shredded by SecureUniquePtr
+    if (mUsed > inlineSize()) {
+        SecureUniquePtr<uint8_t[]> newData(mUsed, allocationResource(mUsed));
+        newData.shredStrategy(shredStrategy());
+        memcpy(newData().get(), mData().get() + mOffset, mUsed);
+
+        countReallocation(mUsed);
+        mData = std::move(newData);
+        mData.dirty(mUsed);
+    } else {
+        // small data moves to the inline storage, an empty Buffer goes back to the unallocated state
+        if (mUsed != 0)
+            memcpy(mInline, mData().get() + mOffset, mUsed);
+        resetStorage(mUsed, mUsed);
+    }
+
+    mOffset = 0;
+}
+
+template<typename SizeT>
+void BasicBuffer<SizeT>::shredStrategy(ShredStrategy strategy) {
+    mData.shredStrategy(strategy);
+}
+
+template<typename SizeT>
+SizeT BasicBuffer<SizeT>::capacity() const {
+    return reserved() - mOffset;
+}
+
+template<typename SizeT>
+void BasicBuffer<SizeT>::padd(const SizeT offset, const SizeT size, const uint8_t value) {
     increase(make_si(offset) + make_si(size), value);
     // do not overwrite existing bytes with supplied value (bytes with offset < mUsed). New bytes have been set to value
     // already by increase(..)
@@ -162,27 +344,32 @@ void Buffer::padd(const uint32_t offset, const uint32_t size, const uint8_t valu
         use(make_si(offset) + make_si(size) - mUsed);
 }
 
-void Buffer::padd(const uint32_t newSize, const uint8_t value) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::padd(const SizeT newSize, const uint8_t value) {
     if (newSize > mUsed)
         padd(mUsed, make_si(newSize) - mUsed, value);
 }
 
-void Buffer::padd(BufferRange range, uint8_t value) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::padd(BufferRange range, uint8_t value) {
     padd(range.offset(), range.size(), value);
 }
 
-uint32_t Buffer::size() const {
+template<typename SizeT>
+SizeT BasicBuffer<SizeT>::size() const {
     return mUsed;
 }
 
-const void *Buffer::const_data_raw(uint32_t p) const {
+template<typename SizeT>
+const void *BasicBuffer<SizeT>::const_data_raw(SizeT p) const {
     if (p > size())
         p = size();
 
-    return &mData()[mOffset + make_si(p)];
+    return storage() + (mOffset + make_si(p));
 }
 
-BufferRangeConst Buffer::const_data(uint32_t offset, uint32_t sz) const {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::const_data(SizeT offset, SizeT sz) const -> BufferRangeConst {
     if (offset > size())
         offset = size();
 
@@ -192,45 +379,77 @@ BufferRangeConst Buffer::const_data(uint32_t offset, uint32_t sz) const {
     return {*this, offset, sz};
 }
 
-void *Buffer::data_raw(uint32_t p) {
+template<typename SizeT>
+void *BasicBuffer<SizeT>::data_raw(SizeT p) {
     if (p > size())
         p = size();
 
-    return &mData()[mOffset + make_si(p)];
+    // callers may write to the free capacity behind the used bytes without committing them
+    markDirty(reserved());
+
+    return storage() + (mOffset + make_si(p));
 }
 
-BufferRange Buffer::data(uint32_t offset, uint32_t sz) {
+template<typename SizeT>
+auto BasicBuffer<SizeT>::data(SizeT offset, SizeT sz) -> BufferRange {
     padd(offset, sz);
     return {*this, offset, sz};
 }
 
-void Buffer::clear(bool shred) {
+template<typename SizeT>
+void BasicBuffer<SizeT>::clear(bool shred) {
     mOffset = 0;
     mUsed = 0;
 
-    // overwrite memory securely
-    if (shred)
-        MemoryShredder::shred(mData().get(), mReserved);
+    // overwrite memory securely, only bytes that ever held data. Pages can be discarded instead.
+    if (shred) {
+        if (mData() && mData.resource() == SecurePages::resource())
+            MemoryShredder::discard(storage(), mData.dirty(), shredStrategy());
+        else
+            MemoryShredder::shred(storage(), mData.dirty(), shredStrategy());
+        mData.dirty(0);
+    }
 }
 
-bool Buffer::operator==(const Buffer &other) const {
+template<typename SizeT>
+bool BasicBuffer<SizeT>::operator==(const BasicBuffer &other) const {
     return size() == other.size() && comparisonHelper(const_data(), other.const_data(), this->size());
 }
 
-Buffer &Buffer::operator=(Buffer &&other) noexcept {
-    mData = std::move(other.mData);
-    mReserved = other.mReserved;
-    mOffset = other.mOffset;
-    mUsed = other.mUsed;
-
-    other.mReserved = 0;
-    other.mOffset = 0;
-    other.mUsed = 0;
+template<typename SizeT>
+BasicBuffer<SizeT> &BasicBuffer<SizeT>::operator=(BasicBuffer &&other) noexcept {
+    // handle self-assignment
+    if (this != &other) {
+        // shred own inline storage before it is dropped, heap storage is shredded by SecureUniquePtr
+        if (isInline())
+            MemoryShredder::shred(mInline, mData.dirty(), shredStrategy());
+
+        mData = std::move(other.mData);
+        mOffset = other.mOffset;
+        mUsed = other.mUsed;
+        mPolicy = other.mPolicy;
+#ifdef SECURE_MEMORY_BUFFER_STATS
+        mStats = other.mStats;
+        other.mStats = {};
+#endif
+
+        // inline storage cannot be moved, copy it and shred the original
+        if (isInline()) {
+            memcpy(mInline, other.mInline, mData.dirty());
+            MemoryShredder::shred(other.mInline, mData.dirty(), shredStrategy());
+        }
+
+        // leave other in unallocated default state, keeping resource and strategy
+        other.mData.ptr().get_deleter() = Deleter(0, resource(), shredStrategy());
+        other.mOffset = 0;
+        other.mUsed = 0;
+    }
 
     return *this;
 }
 
-Buffer &Buffer::operator=(const Buffer &other) noexcept {
+template<typename SizeT>
+BasicBuffer<SizeT> &BasicBuffer<SizeT>::operator=(const BasicBuffer &other) noexcept {
     // handle self-assignment
     if (this != &other) {
         clear();
@@ -240,8 +459,10 @@ Buffer &Buffer::operator=(const Buffer &other) noexcept {
     return *this;
 }
 
-void Buffer::serialize(BufferRange &out) const {
-    uint32_t sz = hton(size());
+template<typename SizeT>
+void BasicBuffer<SizeT>::serialize(BufferRange &out) const {
+    // the size prefix has the width of SizeT
+    SizeT sz = hton(size());
 
     out.write(&sz, sizeof(sz));
     out += sizeof(sz);
@@ -249,13 +470,14 @@ void Buffer::serialize(BufferRange &out) const {
     out += size();
 }
 
-bool Buffer::deserialize(BufferRangeConst &in) {
+template<typename SizeT>
+bool BasicBuffer<SizeT>::deserialize(BufferRangeConst &in) {
     clear();
-    if(in.size() < sizeof(uint32_t))
+    if(in.size() < sizeof(SizeT))
         return false;
 
-    uint32_t sz = ntoh(*in.const_data<uint32_t>());
-    in += sizeof(uint32_t);
+    SizeT sz = ntoh(*in.template const_data<SizeT>());
+    in += sizeof(SizeT);
 
     if(in.size() < sz)
         return false;
@@ -265,7 +487,167 @@ bool Buffer::deserialize(BufferRangeConst &in) {
     return true;
 }
 
-std::size_t std::hash<const Buffer>::operator()(const Buffer &k) const {
-    return std::hash<const BufferRangeConst>().operator()(k);
+#ifndef _WIN32
+template<typename SizeT>
+ssize_t BasicBuffer<SizeT>::readFrom(int fd, SizeT max) {
+    // a single read cannot return more than SSIZE_MAX bytes
+    MutableBufferView free = prepare(static_cast<SizeT>(std::min<uint64_t>(max, SSIZE_MAX)));
+
+    // reading 0 bytes would be indistinguishable from end of file
+    if (free.size() == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ssize_t r = ::read(fd, free.data(), free.size());
+    if (r > 0)
+        commit(static_cast<SizeT>(r));
+
+    return r;
+}
+
+template<typename SizeT>
+ssize_t BasicBuffer<SizeT>::writeTo(int fd) {
+    ssize_t r = ::write(fd, const_data(), std::min<uint64_t>(size(), SSIZE_MAX));
+    if (r > 0)
+        consume(static_cast<SizeT>(r));
+
+    return r;
+}
+
+template<typename SizeT>
+ssize_t BasicBuffer<SizeT>::readFrom(int fd, BasicBuffer *const *buffers, size_t count) {
+    iovec iov[IO_VECTORS];
+    count = std::min(count, IO_VECTORS);
+
+    for (size_t i = 0; i < count; i++) {
+        BasicBuffer &b = *buffers[i];
+        iov[i].iov_base = b.storage() != nullptr ? b.storage() + (b.mOffset + b.mUsed) : nullptr;
+        iov[i].iov_len = b.capacity() - b.mUsed;
+    }
+
+    ssize_t r = ::readv(fd, iov, static_cast<int>(count));
+
+    // distribute read bytes over the Buffers in order
+    auto remaining = static_cast<uint64_t>(std::max<ssize_t>(r, 0));
+    for (size_t i = 0; i < count && remaining != 0; i++) {
+        auto part = static_cast<SizeT>(std::min<uint64_t>(remaining, iov[i].iov_len));
+        buffers[i]->use(part);
+        remaining -= part;
+    }
+
+    return r;
+}
+
+template<typename SizeT>
+ssize_t BasicBuffer<SizeT>::writeTo(int fd, BasicBuffer *const *buffers, size_t count) {
+    iovec iov[IO_VECTORS];
+    count = std::min(count, IO_VECTORS);
+
+    for (size_t i = 0; i < count; i++) {
+        iov[i].iov_base = const_cast<void *>(buffers[i]->const_data_raw());
+        iov[i].iov_len = buffers[i]->size();
+    }
+
+    ssize_t r = ::writev(fd, iov, static_cast<int>(count));
+
+    // consume written bytes from the Buffers in order
+    auto remaining = static_cast<uint64_t>(std::max<ssize_t>(r, 0));
+    for (size_t i = 0; i < count && remaining != 0; i++) {
+        auto part = static_cast<SizeT>(std::min<uint64_t>(remaining, iov[i].iov_len));
+        buffers[i]->consume(part);
+        remaining -= part;
+    }
+
+    return r;
+}
+#endif
+
+/* PRIVATE */
+template<typename SizeT>
+void BasicBuffer<SizeT>::ensureCapacity(SafeInt<SizeT> needed) {
+    if (mOffset + needed > reserved() && !compact(needed))
+        increase(grow(needed));
+}
+
+template<typename SizeT>
+SafeInt<SizeT> BasicBuffer<SizeT>::grow(SafeInt<SizeT> needed) {
+    SafeInt<SizeT> capa;
+
+    switch (mPolicy.growth) {
+        case BufferGrowth::Triple:
+            // requested size includes the consumed bytes, which are dropped when reallocating
+            return mOffset + needed + reserved() * make_si<SizeT>(2);
+        case BufferGrowth::Double:
+            capa = reserved() * make_si<SizeT>(2);
+            break;
+        case BufferGrowth::OneAndHalf:
+            capa = reserved() + make_si<SizeT>(reserved() / 2);
+            break;
+        case BufferGrowth::Exact:
+            break;
+        case BufferGrowth::Page: {
+            SizeT page = pageSize(), rem = needed % page;
+            // saturates to max if rounding up overflows
+            return rem == 0 ? needed : needed + make_si(page - rem);
+        }
+    }
+
+    return capa > needed ? capa : needed;
+}
+
+template<typename SizeT>
+bool BasicBuffer<SizeT>::remap(SafeInt<SizeT> capa) {
+    // keep the consumed bytes, moving them would cost a pass over the data
+    SizeT reserved = mOffset + capa;
+    void *data = SecurePages::reallocate(mData().get(), mData.size(), reserved);
+    if (data == nullptr)
+        return false;
+
+    // the old pages now belong to the new mapping, which takes over the dirty mark
+    Deleter deleter(reserved, SecurePages::resource(), shredStrategy());
+    deleter.dirty(mData.dirty());
+    mData.ptr().release();
+    mData.ptr().reset(static_cast<uint8_t *>(data));
+    mData.ptr().get_deleter() = deleter;
+
+    countReallocation(0);
+    return true;
+}
+
+template<typename SizeT>
+void BasicBuffer<SizeT>::resetStorage(SizeT reserved, SizeT dirty) {
+    Deleter deleter(reserved, resource(), shredStrategy());
+    deleter.dirty(dirty);
+
+    // heap storage is shredded by SecureUniquePtr
+    mData = SecureUniquePtr<uint8_t[]>();
+    mData.ptr().get_deleter() = deleter;
+}
+
+template<typename SizeT>
+bool BasicBuffer<SizeT>::compact(SafeInt<SizeT> capa) {
+    if (mOffset == 0u || capa > reserved())
+        return false;
+
+    // moving nothing is free, otherwise enough bytes must have been consumed to be worth it
+    auto consumed = make_si<uint64_t>(mOffset) * 100_si64;
+    if (mUsed != 0 && consumed < make_si<uint64_t>(reserved()) * make_si<uint64_t>(mPolicy.compactionThreshold))
+        return false;
+
+    memmove(storage(), storage() + mOffset, mUsed);
+    mOffset = 0;
+    countCompaction(mUsed);
+    return true;
+}
+
+template class BasicBuffer<uint32_t>;
+template class BasicBuffer<uint64_t>;
+
+template<typename SizeT>
+std::size_t std::hash<const BasicBuffer<SizeT>>::operator()(const BasicBuffer<SizeT> &k) const {
+    return std::hash<const typename BasicBuffer<SizeT>::BufferRangeConst>().operator()(k);
 }
 
+template struct std::hash<const Buffer>;
+template struct std::hash<const Buffer64>;
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <secure_memory/BufferChain.h>
+#include <secure_memory/BufferRange.h>
+
+BufferChain::BufferChain(uint32_t segmentSize) : mSegmentSize(std::max(segmentSize, 1u)) { }
+
+BufferChain::BufferChain(BufferChain &&other) : mSegments(std::move(other.mSegments)),
+        mSegmentSize(other.mSegmentSize), mSize(other.mSize) {
+    other.mSegments.clear();
+    other.mSize = 0;
+}
+
+BufferChain &BufferChain::operator=(BufferChain &&other) noexcept {
+    if (this != &other) {
+        mSegments = std::move(other.mSegments);
+        mSegmentSize = other.mSegmentSize;
+        mSize = other.mSize;
+
+        other.mSegments.clear();
+        other.mSize = 0;
+    }
+    return *this;
+}
+
+void BufferChain::append(const void *data, uint64_t len) {
+    auto bytes = static_cast<const uint8_t *>(data);
+
+    // fill the last segment without reallocating it
+    if (!mSegments.empty()) {
+        Buffer &last = mSegments.back();
+        uint32_t part = static_cast<uint32_t>(std::min<uint64_t>(len, last.capacity() - last.size()));
+
+        last.append(bytes, part);
+        mSize += part;
+        bytes += part;
+        len -= part;
+    }
+
+    // remaining data goes into new segments
+    while (len != 0) {
+        uint32_t part = static_cast<uint32_t>(std::min<uint64_t>(len, mSegmentSize));
+
+        mSegments.emplace_back(mSegmentSize);
+        mSegments.back().append(bytes, part);
+        mSize += part;
+        bytes += part;
+        len -= part;
+    }
+}
+
+void BufferChain::append(const BufferRangeConst &range) {
+    append(range.const_data(), range.size());
+}
+
+void BufferChain::append(Buffer &&segment) {
+    if (segment.empty())
+        return;
+
+    mSize += segment.size();
+    mSegments.push_back(std::move(segment));
+}
+
+void BufferChain::consume(uint64_t n) {
+    n = std::min(n, mSize);
+    mSize -= n;
+
+    // release whole segments, their destructors shred the memory
+    while (n != 0 && n >= mSegments.front().size()) {
+        n -= mSegments.front().size();
+        mSegments.pop_front();
+    }
+    if (n != 0)
+        mSegments.front().consume(static_cast<uint32_t>(n));
+}
+
+uint64_t BufferChain::copyTo(void *out, uint64_t len, uint64_t offset) const {
+    auto dest = static_cast<uint8_t *>(out);
+    uint64_t copied = 0;
+
+    for (const BufferRangeConst &range : const_data(offset, len)) {
+        memcpy(dest + copied, range.const_data(), range.size());
+        copied += range.size();
+    }
+    return copied;
+}
+
+Buffer64 BufferChain::flatten() const {
+    Buffer64 result(mSize);
+    for (const Buffer &segment : mSegments)
+        result.append(segment.view());
+
+    return result;
+}
+
+std::vector<BufferRangeConst> BufferChain::const_data(uint64_t offset, uint64_t size) const {
+    std::vector<BufferRangeConst> ranges;
+
+    for (const Buffer &segment : mSegments) {
+        if (size == 0)
+            break;
+
+        // skip segments in front of offset
+        if (offset >= segment.size()) {
+            offset -= segment.size();
+            continue;
+        }
+
+        auto off = static_cast<uint32_t>(offset);
+        auto part = static_cast<uint32_t>(std::min<uint64_t>(size, segment.size() - off));
+        ranges.emplace_back(segment, off, part);
+
+        offset = 0;
+        size -= part;
+    }
+    return ranges;
+}
+
+std::vector<BufferView> BufferChain::views() const {
+    std::vector<BufferView> result;
+    result.reserve(mSegments.size());
+
+    for (const Buffer &segment : mSegments)
+        result.emplace_back(segment.const_data(), segment.size());
+    return result;
+}
+
+void BufferChain::clear() {
+    mSegments.clear();
+    mSize = 0;
+}
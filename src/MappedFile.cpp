@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WIN32
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <secure_memory/MappedFile.h>
+#include <secure_memory/MemoryShredder.h>
+#include "PageSize.h"
+
+#ifdef __linux__
+// flags of /proc/self/pagemap entries
+static constexpr uint64_t PAGEMAP_PRESENT = 1ull << 63, PAGEMAP_SWAPPED = 1ull << 62, PAGEMAP_FILE = 1ull << 61;
+#endif
+
+/**
+ * Shreds the pages of a private mapping that have been copied on write. Without pagemap, all pages are shredded.
+ *
+ * @param data Page aligned start of the pages
+ * @param len Length in bytes
+ * @param pagemap Descriptor of /proc/self/pagemap or -1
+ */
+static void shredPages(uint8_t *data, size_t len, int pagemap) {
+#ifdef __linux__
+    if (pagemap >= 0) {
+        size_t page = pageSize(), run = SIZE_MAX;
+        uint64_t entries[512];
+
+        for (size_t offset = 0; offset < len;) {
+            size_t count = std::min<size_t>((len - offset + page - 1) / page, 512);
+            auto pos = static_cast<off_t>(reinterpret_cast<uintptr_t>(data + offset) / page * sizeof(uint64_t));
+            bool known = ::pread(pagemap, entries, count * sizeof(uint64_t), pos)
+                         == static_cast<ssize_t>(count * sizeof(uint64_t));
+
+            for (size_t i = 0; i < count; i++, offset += page) {
+                // swapped and present anonymous pages are copies, pages of unknown state might be
+                uint64_t entry = entries[i];
+                bool copied = !known || (entry & PAGEMAP_SWAPPED) != 0
+                              || ((entry & PAGEMAP_PRESENT) != 0 && (entry & PAGEMAP_FILE) == 0);
+
+                // shred runs of copied pages at once
+                if (copied && run == SIZE_MAX) {
+                    run = offset;
+                } else if (!copied && run != SIZE_MAX) {
+                    MemoryShredder::shred(data + run, offset - run);
+                    run = SIZE_MAX;
+                }
+            }
+        }
+
+        if (run != SIZE_MAX)
+            MemoryShredder::shred(data + run, len - run);
+        return;
+    }
+#else
+    (void) pagemap;
+#endif
+
+    MemoryShredder::shred(data, len);
+}
+
+MappedFile::MappedFile(const std::string &path, Mode mode) {
+    map(path, mode);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+        : mData(other.mData), mSize(other.mSize), mMapped(other.mMapped), mMode(other.mMode),
+          mDirtyPages(std::move(other.mDirtyPages)) {
+    // leave other unmapped
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mMapped = false;
+    other.mDirtyPages.clear();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mMapped = other.mMapped;
+        mMode = other.mMode;
+        mDirtyPages = std::move(other.mDirtyPages);
+
+        // leave other unmapped
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mMapped = false;
+        other.mDirtyPages.clear();
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+bool MappedFile::map(const std::string &path, Mode mode) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // the mapping stays valid after closing the descriptor, keep errno of a failed mapping
+    bool result = map(fd, mode);
+    int error = errno;
+    ::close(fd);
+
+    errno = error;
+    return result;
+}
+
+bool MappedFile::map(int fd, Mode mode) {
+    unmap();
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0)
+        return false;
+
+    auto size = static_cast<uint64_t>(st.st_size);
+    if (size > SIZE_MAX) {
+        errno = EFBIG;
+        return false;
+    }
+
+    // mapping an empty file is not possible, but there is nothing to access either
+    if (size != 0) {
+        int prot = mode == Mode::Private ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *data = ::mmap(nullptr, static_cast<size_t>(size), prot, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+            return false;
+
+        mData = static_cast<uint8_t *>(data);
+    }
+
+    mSize = size;
+    mMode = mode;
+    mMapped = true;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (!mMapped)
+        return;
+
+    if (mData != nullptr) {
+        // shred copy-on-write pages only, touching clean pages would copy them
+        int pagemap = -1;
+#ifdef __linux__
+        if (!mDirtyPages.empty())
+            pagemap = ::open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+#endif
+
+        uint64_t page = pageSize();
+        for (size_t first = 0, last; first < mDirtyPages.size(); first = last) {
+            last = first + 1;
+            if (!mDirtyPages[first])
+                continue;
+
+            // runs of dirty pages, the last page may be partial
+            while (last < mDirtyPages.size() && mDirtyPages[last])
+                last++;
+            uint64_t begin = first * page, end = std::min(last * page, mSize);
+            shredPages(mData + begin, static_cast<size_t>(end - begin), pagemap);
+        }
+
+        if (pagemap >= 0)
+            ::close(pagemap);
+        ::munmap(mData, static_cast<size_t>(mSize));
+    }
+
+    mData = nullptr;
+    mSize = 0;
+    mMapped = false;
+    mDirtyPages = std::vector<bool>();
+}
+
+const void *MappedFile::const_data_raw(uint64_t p) const {
+    if (p > mSize)
+        p = mSize;
+
+    return mData + p;
+}
+
+MappedFileRangeConst MappedFile::const_data(uint64_t offset, uint64_t sz) const {
+    if (offset > mSize)
+        offset = mSize;
+    if (sz > mSize - offset)
+        sz = mSize - offset;
+
+    return {*this, offset, sz};
+}
+
+BufferView MappedFile::view(uint64_t offset, uint64_t sz) const {
+    return const_data(offset, sz).view();
+}
+
+void *MappedFile::data_raw(uint64_t p) {
+    if (mMode != Mode::Private)
+        return nullptr;
+    if (p > mSize)
+        p = mSize;
+
+    markDirty(p, mSize);
+    return mData + p;
+}
+
+MappedFileRange MappedFile::data(uint64_t offset, uint64_t sz) {
+    if (offset > mSize)
+        offset = mSize;
+    if (sz > mSize - offset)
+        sz = mSize - offset;
+
+    if (mMode == Mode::Private)
+        markDirty(offset, offset + sz);
+    return {*this, offset, sz};
+}
+
+void MappedFile::write(const void *data, uint64_t len, uint64_t offset) {
+    if (mMode != Mode::Private || offset >= mSize)
+        return;
+    if (len > mSize - offset)
+        len = mSize - offset;
+
+    if (data != nullptr && len != 0) {
+        markDirty(offset, offset + len);
+        memcpy(mData + offset, data, static_cast<size_t>(len));
+    }
+}
+
+bool MappedFile::isDirty(uint64_t offset) const {
+    uint64_t index = offset / pageSize();
+    return index < mDirtyPages.size() && mDirtyPages[static_cast<size_t>(index)];
+}
+
+/* PRIVATE */
+void MappedFile::markDirty(uint64_t begin, uint64_t end) {
+    if (begin >= end)
+        return;
+
+    uint64_t page = pageSize();
+    if (mDirtyPages.empty())
+        mDirtyPages.resize(static_cast<size_t>((mSize + page - 1) / page));
+
+    auto first = static_cast<ptrdiff_t>(begin / page), last = static_cast<ptrdiff_t>((end - 1) / page);
+    std::fill(mDirtyPages.begin() + first, mDirtyPages.begin() + last + 1, true);
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2015-2023 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+    #include <sys/random.h>
+    #include <cerrno>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    #include <cstdlib>
+    #define SM_SUP_ARC4RANDOM 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SM_SUP_NON_TEMPORAL 1
+#endif
+
+#include <secure_memory/MemoryShredder.h>
+#include "PageSize.h"
+
+#if defined(__GNUC__) || !defined(__clang__)
+#define SM_SUP_ASM_BARRIER 1
+#endif
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+/**
+ * Fills memory with bytes of the operating system's CSPRNG.
+ */
+static void fillSecureRandom(uint8_t *data, size_t size) {
+#if defined(__linux__)
+    while (size != 0) {
+        ssize_t read = getrandom(data, size, 0);
+        if (read < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        data += read;
+        size -= static_cast<size_t>(read);
+    }
+    if (size == 0)
+        return;
+#elif defined(SM_SUP_ARC4RANDOM)
+    arc4random_buf(data, size);
+    return;
+#endif
+
+    // fallback, also covers getrandom failing on kernels without it
+    thread_local std::random_device device;
+    while (size != 0) {
+        auto value = static_cast<uint32_t>(device());
+        size_t count = std::min(size, sizeof(value));
+        memcpy(data, &value, count);
+        data += count;
+        size -= count;
+    }
+}
+
+/**
+ * Fills memory through the cache.
+ */
+static void fillCached(uint8_t *data, size_t size, ShredStrategy strategy, SplitMix64x8 &rng) {
+    switch (strategy) {
+        case ShredStrategy::Zero:
+            memset(data, 0, size);
+            break;
+        case ShredStrategy::Pattern:
+            memset(data, MemoryShredder::PATTERN, size);
+            break;
+        case ShredStrategy::PRNG:
+            rng.nextBytes(data, size);
+            break;
+        case ShredStrategy::CSPRNG:
+            fillSecureRandom(data, size);
+            break;
+    }
+}
+
+#ifdef SM_SUP_NON_TEMPORAL
+/**
+ * Fills memory with non-temporal stores, which write around the cache instead of evicting other lines from it. The
+ * unaligned edges are filled through the cache.
+ */
+static void fillStreaming(uint8_t *data, size_t size, ShredStrategy strategy, SplitMix64x8 &rng) {
+    size_t head = (sizeof(__m128i) - reinterpret_cast<uintptr_t>(data) % sizeof(__m128i)) % sizeof(__m128i);
+    size_t count = (size - head) / sizeof(__m128i);
+    auto *dst = reinterpret_cast<__m128i *>(data + head);
+
+    fillCached(data, head, strategy, rng);
+    switch (strategy) {
+        case ShredStrategy::Zero:
+        case ShredStrategy::Pattern: {
+            auto byte = static_cast<char>(strategy == ShredStrategy::Zero ? 0 : MemoryShredder::PATTERN);
+            __m128i value = _mm_set1_epi8(byte);
+            for (size_t i = 0; i < count; i++)
+                _mm_stream_si128(dst + i, value);
+            break;
+        }
+        case ShredStrategy::PRNG:
+        case ShredStrategy::CSPRNG: {
+            // random bytes are drawn into a small buffer that stays in L1
+            alignas(__m128i) uint8_t chunk[4096];
+            for (size_t i = 0; i < count; i += sizeof(chunk) / sizeof(__m128i)) {
+                size_t n = std::min(sizeof(chunk) / sizeof(__m128i), count - i);
+                if (strategy == ShredStrategy::PRNG)
+                    rng.nextBytes(chunk, n * sizeof(__m128i));
+                else
+                    fillSecureRandom(chunk, n * sizeof(__m128i));
+                for (size_t j = 0; j < n; j++)
+                    _mm_stream_si128(dst + i + j, _mm_load_si128(reinterpret_cast<const __m128i *>(chunk) + j));
+            }
+            break;
+        }
+    }
+    fillCached(data + head + count * sizeof(__m128i), size - head - count * sizeof(__m128i), strategy, rng);
+
+    // non-temporal stores are weakly ordered, make them visible before the memory is released
+    _mm_sfence();
+}
+#endif
+#endif
+
+void MemoryShredder::shred(void *data, size_t size, ShredStrategy strategy) {
+    if (data == nullptr || size == 0)
+        return;
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+    auto *bytes = static_cast<uint8_t *>(data);
+#ifdef SM_SUP_NON_TEMPORAL
+    if (size >= NON_TEMPORAL_MIN_SIZE)
+        fillStreaming(bytes, size, strategy, sRng);
+    else
+        fillCached(bytes, size, strategy, sRng);
+#else
+    fillCached(bytes, size, strategy, sRng);
+#endif
+#else
+    (void) strategy;
+    #warning "Disabled secure unique ptr deletion"
+#endif
+
+#ifdef SM_SUP_ASM_BARRIER
+    __asm__ __volatile__(""::"r"(data): "memory");
+#else
+    volatile auto *buf = (volatile uint8_t *) data;
+    buf[0] = buf[0];
+#endif
+}
+
+void MemoryShredder::discard(void *data, size_t len, ShredStrategy strategy) {
+#if defined(__linux__) && defined(SECURE_MEMORY_UNIQUE_PTR_SHRED)
+    if (data != nullptr && len >= DISCARD_MIN_SIZE) {
+        uintptr_t page = pageSize(), begin = reinterpret_cast<uintptr_t>(data), end = begin + len;
+        uintptr_t first = (begin + page - 1) & ~(page - 1), last = end & ~(page - 1);
+
+        // whole pages are dropped, the partial pages at the edges are overwritten
+        if (::madvise(reinterpret_cast<void *>(first), last - first, MADV_DONTNEED) == 0) {
+            shred(data, first - begin, strategy);
+            shred(reinterpret_cast<void *>(last), end - last, strategy);
+            return;
+        }
+    }
+#endif
+
+    shred(data, len, strategy);
+}
+
+thread_local SplitMix64x8 MemoryShredder::sRng(std::random_device().operator()());
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015-2023 The ViaDuck Project
+ * Copyright (C) 2026 The ViaDuck Project
  *
  * This file is part of SecureMemory.
  *
@@ -17,30 +17,29 @@
  * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <random>
+#ifndef SECUREMEMORY_PAGESIZE_H
+#define SECUREMEMORY_PAGESIZE_H
 
-#include <secure_memory/SecureUniquePtr.h>
-
-#if defined(__GNUC__) || !defined(__clang__)
-#define SM_SUP_ASM_BARRIER 1
-#endif
-
-void MemoryShredder::shred(void *data, size_t size) {
-    if (data == nullptr || size == 0)
-        return;
-
-#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
-    sRng.nextBytes(static_cast<uint8_t *>(data), size);
+#ifdef _WIN32
+    #include <windows.h>
 #else
-    #warning "Disabled secure unique ptr deletion"
+    #include <unistd.h>
 #endif
 
-#ifdef SM_SUP_ASM_BARRIER
-    __asm__ __volatile__(""::"r"(data): "memory");
+#include <cstdint>
+
+/**
+ * @return The system's memory page size in bytes
+ */
+static inline uint32_t pageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    static const uint32_t size = info.dwPageSize;
 #else
-    volatile auto *buf = (volatile uint8_t *) data;
-    buf[0] = buf[0];
+    static const uint32_t size = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
 #endif
+    return size;
 }
 
-thread_local SplitMix64 MemoryShredder::sRng(std::random_device().operator()());
+#endif //SECUREMEMORY_PAGESIZE_H
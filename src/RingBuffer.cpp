@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <secure_memory/RingBuffer.h>
+#include <secure_memory/BufferRange.h>
+
+RingBuffer::RingBuffer(uint32_t capacity) : mData(capacity) { }
+
+RingBuffer::RingBuffer(RingBuffer &&other) noexcept : mHead(other.mHead), mSize(other.mSize),
+        mData(std::move(other.mData)) {
+    other.mHead = 0;
+    other.mSize = 0;
+}
+
+RingBuffer &RingBuffer::operator=(RingBuffer &&other) noexcept {
+    if (this != &other) {
+        // SecureUniquePtr shreds our memory before taking over other's
+        mData = std::move(other.mData);
+        mHead = other.mHead;
+        mSize = other.mSize;
+
+        other.mHead = 0;
+        other.mSize = 0;
+    }
+    return *this;
+}
+
+uint32_t RingBuffer::write(const void *data, uint32_t len) {
+    auto regions = writable();
+    len = std::min(len, available());
+
+    // fill the space up to the end of the allocation first, then wrap around
+    uint32_t first = std::min<uint32_t>(len, regions.first.size());
+    if (first != 0)
+        memcpy(regions.first.data(), data, first);
+    if (len != first)
+        memcpy(regions.second.data(), static_cast<const uint8_t *>(data) + first, len - first);
+
+    commit(len);
+    return len;
+}
+
+uint32_t RingBuffer::write(const BufferRangeConst &range) {
+    return write(range.const_data(), range.size());
+}
+
+uint32_t RingBuffer::read(void *out, uint32_t len) {
+    len = peek(out, len);
+    consume(len);
+    return len;
+}
+
+uint32_t RingBuffer::read(Buffer &out, uint32_t len) {
+    auto regions = readable();
+    len = std::min(len, mSize);
+
+    uint32_t first = std::min<uint32_t>(len, regions.first.size());
+    out.append(regions.first.data(), first);
+    out.append(regions.second.data(), len - first);
+
+    consume(len);
+    return len;
+}
+
+uint32_t RingBuffer::peek(void *out, uint32_t len, uint32_t offset) const {
+    offset = std::min(offset, mSize);
+    len = std::min(len, mSize - offset);
+
+    auto regions = readable();
+    auto first = regions.first.subview(offset, len);
+    auto second = regions.second.subview(offset - std::min<uint32_t>(offset, regions.first.size()),
+                                         len - first.size());
+
+    if (!first.empty())
+        memcpy(out, first.data(), first.size());
+    if (!second.empty())
+        memcpy(static_cast<uint8_t *>(out) + first.size(), second.data(), second.size());
+
+    return len;
+}
+
+void RingBuffer::consume(uint32_t n) {
+    n = std::min(n, mSize);
+    mSize -= n;
+
+    // advance the head, wrapping around at the end of the allocation
+    mHead = n < capacity() - mHead ? mHead + n : n - (capacity() - mHead);
+    // start at the beginning if empty, so the next write is contiguous as long as possible
+    if (mSize == 0)
+        mHead = 0;
+}
+
+void RingBuffer::commit(uint32_t n) {
+    mSize += std::min(n, available());
+}
+
+RingBuffer::Regions<BufferView> RingBuffer::readable() const {
+    const uint8_t *data = mData().get();
+    uint32_t toEnd = capacity() - mHead;
+
+    if (mSize <= toEnd)
+        return {{data + mHead, mSize}, {}};
+    return {{data + mHead, toEnd}, {data, mSize - toEnd}};
+}
+
+RingBuffer::Regions<MutableBufferView> RingBuffer::writable() {
+    uint8_t *data = mData().get();
+    uint32_t toEnd = capacity() - mHead;
+
+    // free space starts behind the readable bytes and ends at the head
+    if (mSize >= toEnd)
+        return {{data + (mSize - toEnd), available()}, {}};
+    return {{data + mHead + mSize, toEnd - mSize}, {data, mHead}};
+}
+
+void RingBuffer::clear(bool shred) {
+    mHead = 0;
+    mSize = 0;
+
+    // overwrite memory securely
+    if (shred)
+        MemoryShredder::shred(mData().get(), capacity(), mData.shredStrategy());
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+#include <secure_memory/SecureHeap.h>
+#include "PageSize.h"
+#include "SizeClass.h"
+
+// number of size classes: MIN_SIZE_CLASS, 2 * MIN_SIZE_CLASS, ..., MAX_BLOCK_SIZE
+static constexpr size_t SIZE_CLASSES = 13;
+static_assert(MIN_SIZE_CLASS << (SIZE_CLASSES - 1) == SecureHeap::MAX_BLOCK_SIZE, "Size classes mismatch");
+static_assert(SecureHeap::REGION_SIZE % SecureHeap::MAX_BLOCK_SIZE == 0, "Regions must hold whole blocks");
+
+/**
+ * Maps size bytes of locked memory between two guard pages.
+ *
+ * @param size Size in bytes, a multiple of the page size
+ * @return Pointer to the usable memory, nullptr on failure
+ */
+static uint8_t *mapLocked(size_t size) {
+    size_t page = pageSize();
+
+#ifdef _WIN32
+    auto *base = static_cast<uint8_t *>(VirtualAlloc(nullptr, size + 2 * page, MEM_RESERVE | MEM_COMMIT,
+                                                     PAGE_READWRITE));
+    if (base == nullptr)
+        return nullptr;
+
+    DWORD old;
+    if (!VirtualProtect(base, page, PAGE_NOACCESS, &old) ||
+            !VirtualProtect(base + page + size, page, PAGE_NOACCESS, &old) || !VirtualLock(base + page, size)) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        return nullptr;
+    }
+#else
+    void *mapping = ::mmap(nullptr, size + 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    auto *base = static_cast<uint8_t *>(mapping);
+    if (::mprotect(base, page, PROT_NONE) != 0 || ::mprotect(base + page + size, page, PROT_NONE) != 0 ||
+            ::mlock(base + page, size) != 0) {
+        ::munmap(base, size + 2 * page);
+        return nullptr;
+    }
+
+    // best effort, secrets stay out of core dumps where supported
+    #if defined(MADV_DONTDUMP)
+        ::madvise(base + page, size, MADV_DONTDUMP);
+    #elif defined(MADV_NOCORE)
+        ::madvise(base + page, size, MADV_NOCORE);
+    #endif
+#endif
+
+    return base + page;
+}
+
+/**
+ * Unlocks and unmaps memory returned by mapLocked.
+ */
+static void unmapLocked(uint8_t *data, size_t size) {
+    size_t page = pageSize();
+
+#ifdef _WIN32
+    VirtualUnlock(data, size);
+    VirtualFree(data - page, 0, MEM_RELEASE);
+#else
+    ::munlock(data, size);
+    ::munmap(data - page, size + 2 * page);
+#endif
+}
+
+/**
+ * Free lists and bump allocation of the regions, guarded by one mutex.
+ */
+struct HeapState {
+    struct Block {
+        Block *next;
+    };
+
+    uint8_t *carve(size_t index);
+    void recycle(uint8_t *begin, uint8_t *end);
+
+    std::mutex mutex;
+    Block *lists[SIZE_CLASSES] = {};
+    // unused remainder of the newest region
+    uint8_t *bump = nullptr, *bumpEnd = nullptr;
+    SecureHeapStats stats;
+};
+
+// never destroyed, so blocks freed by static objects during program exit remain valid
+static HeapState &heap() {
+    static auto *state = new HeapState();
+    return *state;
+}
+
+/**
+ * @return Alignment of blocks in a size class: their size, at most the page size
+ */
+static inline size_t classAlignment(size_t index) {
+    return std::min<size_t>(MIN_SIZE_CLASS << index, pageSize());
+}
+
+uint8_t *HeapState::carve(size_t index) {
+    size_t blockSize = MIN_SIZE_CLASS << index, alignment = classAlignment(index);
+
+    auto offset = reinterpret_cast<uintptr_t>(bump);
+    auto *aligned = reinterpret_cast<uint8_t *>((offset + alignment - 1) & ~(alignment - 1));
+    if (bump == nullptr || aligned + blockSize > bumpEnd) {
+        uint8_t *region = mapLocked(SecureHeap::REGION_SIZE);
+        if (region == nullptr)
+            throw std::bad_alloc();
+
+        // the rest of the old region stays usable through the free lists
+        recycle(bump, bumpEnd);
+        stats.locked += SecureHeap::REGION_SIZE;
+        stats.mappings++;
+        bump = aligned = region;
+        bumpEnd = region + SecureHeap::REGION_SIZE;
+    }
+
+    // alignment padding is recycled as well
+    recycle(bump, aligned);
+    bump = aligned + blockSize;
+    return aligned;
+}
+
+void HeapState::recycle(uint8_t *begin, uint8_t *end) {
+    // split into the largest naturally aligned blocks
+    while (begin != nullptr && begin + MIN_SIZE_CLASS <= end) {
+        size_t index = SIZE_CLASSES - 1;
+        while (index != 0 && ((MIN_SIZE_CLASS << index) > static_cast<size_t>(end - begin) ||
+                              reinterpret_cast<uintptr_t>(begin) % classAlignment(index) != 0))
+            index--;
+
+        auto *block = reinterpret_cast<Block *>(begin);
+        block->next = lists[index];
+        lists[index] = block;
+        begin += MIN_SIZE_CLASS << index;
+    }
+}
+
+void *SecureHeap::allocate(size_t size, size_t alignment) {
+    size_t page = pageSize();
+    if (alignment > page)
+        throw std::bad_alloc();
+    size = std::max({size, alignment, size_t(1)});
+
+    HeapState &state = heap();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (size > MAX_BLOCK_SIZE) {
+        size_t pages = (size + page - 1) / page * page;
+        uint8_t *data = mapLocked(pages);
+        if (data == nullptr)
+            throw std::bad_alloc();
+
+        state.stats.locked += pages;
+        state.stats.used += pages;
+        state.stats.mappings++;
+        state.stats.allocations++;
+        return data;
+    }
+
+    size_t index = sizeClass(size);
+    uint8_t *data;
+    if (state.lists[index] != nullptr) {
+        data = reinterpret_cast<uint8_t *>(state.lists[index]);
+        state.lists[index] = state.lists[index]->next;
+    } else {
+        data = state.carve(index);
+    }
+
+    state.stats.used += MIN_SIZE_CLASS << index;
+    state.stats.allocations++;
+    return data;
+}
+
+void SecureHeap::deallocate(void *data, size_t size, size_t alignment, ShredStrategy strategy, size_t dirty) {
+    if (data == nullptr)
+        return;
+
+    MemoryShredder::shred(data, std::min(dirty, size), strategy);
+
+    size_t page = pageSize();
+    size = std::max({size, alignment, size_t(1)});
+
+    HeapState &state = heap();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (size > MAX_BLOCK_SIZE) {
+        size_t pages = (size + page - 1) / page * page;
+        unmapLocked(static_cast<uint8_t *>(data), pages);
+
+        state.stats.locked -= pages;
+        state.stats.used -= pages;
+        state.stats.mappings--;
+        return;
+    }
+
+    size_t index = sizeClass(size);
+    auto *block = static_cast<HeapState::Block *>(data);
+    block->next = state.lists[index];
+    state.lists[index] = block;
+    state.stats.used -= MIN_SIZE_CLASS << index;
+}
+
+SecureHeapStats SecureHeap::stats() {
+    HeapState &state = heap();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    SecureHeapStats stats = state.stats;
+    stats.free = stats.locked - stats.used;
+    return stats;
+}
+
+/**
+ * memory_resource adapter of SecureHeap.
+ */
+class SecureHeapResource : public std::pmr::memory_resource {
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        return SecureHeap::allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        SecureHeap::deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::pmr::memory_resource *SecureHeap::resource() {
+    // never destroyed, so it remains usable by static objects during program exit
+    static auto *resource = new SecureHeapResource();
+    return resource;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <secure_memory/BackgroundShredder.h>
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SecurePool.h>
+#include "PageSize.h"
+
+static std::atomic<uint64_t> sAllocations {0};
+
+/**
+ * @return size rounded up to whole pages, at least one page
+ */
+static inline size_t pageRound(size_t size) {
+    size_t page = pageSize();
+    return size <= page ? page : (size + page - 1) / page * page;
+}
+
+/**
+ * Shreds and unmaps a block of size bytes, called on the releasing or the background thread.
+ */
+static void releasePages(void *data, size_t size, ShredStrategy strategy, size_t dirty) {
+#ifdef _WIN32
+    (void) size;
+    MemoryShredder::shred(data, dirty, strategy);
+    VirtualFree(data, 0, MEM_RELEASE);
+#else
+    MemoryShredder::discard(data, dirty, strategy);
+    ::munmap(data, pageRound(size));
+#endif
+}
+
+void *SecurePages::allocate(size_t size) {
+#ifdef _WIN32
+    void *data = VirtualAlloc(nullptr, pageRound(size), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (data == nullptr)
+        throw std::bad_alloc();
+#else
+    void *data = ::mmap(nullptr, pageRound(size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+        throw std::bad_alloc();
+#endif
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    return data;
+}
+
+void SecurePages::deallocate(void *data, size_t size, ShredStrategy strategy, size_t dirty) {
+    if (data == nullptr)
+        return;
+    dirty = std::min(dirty, size);
+
+    if (size > SecurePool::MAX_BLOCK_SIZE && BackgroundShredder::defer(data, size, strategy, dirty, releasePages))
+        return;
+
+    releasePages(data, size, strategy, dirty);
+}
+
+void *SecurePages::reallocate(void *data, size_t size, size_t newSize) {
+#ifdef __linux__
+    size_t oldPages = pageRound(size), newPages = pageRound(newSize);
+    if (oldPages == newPages)
+        return data;
+
+    // the kernel moves the page table entries, the old range is unmapped without copying its contents
+    void *result = ::mremap(data, oldPages, newPages, MREMAP_MAYMOVE);
+    if (result == MAP_FAILED)
+        return nullptr;
+
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    return result;
+#else
+    (void) data;
+    (void) size;
+    (void) newSize;
+    return nullptr;
+#endif
+}
+
+uint64_t SecurePages::allocations() {
+    return sAllocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * memory_resource adapter of SecurePages.
+ */
+class SecurePagesResource : public std::pmr::memory_resource {
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > pageSize())
+            throw std::bad_alloc();
+        return SecurePages::allocate(bytes);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t) override {
+        SecurePages::deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::pmr::memory_resource *SecurePages::resource() {
+    // never destroyed, so it remains usable by static objects during program exit
+    static auto *resource = new SecurePagesResource();
+    return resource;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <secure_memory/BackgroundShredder.h>
+#include <secure_memory/SecurePool.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include "SizeClass.h"
+
+// number of size classes: MIN_BLOCK_SIZE, 2 * MIN_BLOCK_SIZE, ..., MAX_BLOCK_SIZE
+static constexpr size_t SIZE_CLASSES = 13;
+static_assert(SecurePool::MIN_BLOCK_SIZE == MIN_SIZE_CLASS, "Size classes mismatch");
+static_assert(SecurePool::MIN_BLOCK_SIZE << (SIZE_CLASSES - 1) == SecurePool::MAX_BLOCK_SIZE, "Size classes mismatch");
+
+static std::atomic<size_t> sMaxRetained {SecurePool::DEFAULT_MAX_RETAINED};
+
+/**
+ * Free list of blocks per size class. Cached blocks are shredded, only their first bytes link them.
+ */
+struct ThreadCache {
+    struct Block {
+        Block *next;
+    };
+
+    ~ThreadCache();
+    void trim();
+
+    Block *lists[SIZE_CLASSES] = {};
+    SecurePoolStats stats;
+};
+
+// set once the calling thread's cache is destroyed, blocks freed afterwards (e.g. by static objects) bypass it.
+// Trivially destructible, so it remains accessible during thread and program exit.
+static thread_local bool tCacheDestroyed = false;
+static thread_local ThreadCache tCache;
+
+ThreadCache::~ThreadCache() {
+    trim();
+    tCacheDestroyed = true;
+}
+
+void ThreadCache::trim() {
+    for (size_t i = 0; i < SIZE_CLASSES; i++) {
+        while (lists[i] != nullptr) {
+            Block *block = lists[i];
+            lists[i] = block->next;
+            ::operator delete(block);
+        }
+    }
+    stats.retained = 0;
+}
+
+void *SecurePool::allocate(size_t size) {
+    if (size == 0)
+        return nullptr;
+
+#ifdef SECURE_MEMORY_POOL
+    if (size <= MAX_BLOCK_SIZE) {
+        size_t index = sizeClass(size);
+
+        // blocks always span their whole size class, since other threads may cache them when freed
+        if (tCacheDestroyed)
+            return ::operator new(MIN_BLOCK_SIZE << index);
+
+        ThreadCache::Block *block = tCache.lists[index];
+        if (block != nullptr) {
+            tCache.lists[index] = block->next;
+            tCache.stats.retained -= MIN_BLOCK_SIZE << index;
+            tCache.stats.hits++;
+            return block;
+        }
+
+        tCache.stats.misses++;
+        return ::operator new(MIN_BLOCK_SIZE << index);
+    }
+    if (!tCacheDestroyed)
+        tCache.stats.misses++;
+#endif
+
+    return ::operator new(size);
+}
+
+void SecurePool::deallocate(void *data, size_t size, ShredStrategy strategy, size_t dirty) {
+    if (data == nullptr)
+        return;
+    dirty = std::min(dirty, size);
+
+    // uncached blocks may be shredded and freed by the background thread
+    if (size > MAX_BLOCK_SIZE && BackgroundShredder::defer(data, size, strategy, dirty)) {
+#ifdef SECURE_MEMORY_POOL
+        if (!tCacheDestroyed)
+            tCache.stats.releases++;
+#endif
+        return;
+    }
+
+    MemoryShredder::shred(data, dirty, strategy);
+
+#ifdef SECURE_MEMORY_POOL
+    if (!tCacheDestroyed) {
+        if (size <= MAX_BLOCK_SIZE) {
+            size_t index = sizeClass(size), blockSize = MIN_BLOCK_SIZE << index;
+
+            // keep the block unless the cache is full
+            if (tCache.stats.retained + blockSize <= sMaxRetained.load(std::memory_order_relaxed)) {
+                auto *block = static_cast<ThreadCache::Block *>(data);
+                block->next = tCache.lists[index];
+                tCache.lists[index] = block;
+                tCache.stats.retained += blockSize;
+                return;
+            }
+        }
+        tCache.stats.releases++;
+    }
+#endif
+
+    ::operator delete(data);
+}
+
+const SecurePoolStats &SecurePool::stats() {
+    return tCache.stats;
+}
+
+void SecurePool::resetStats() {
+    size_t retained = tCache.stats.retained;
+    tCache.stats = {};
+    tCache.stats.retained = retained;
+}
+
+size_t SecurePool::maxRetained() {
+    return sMaxRetained.load(std::memory_order_relaxed);
+}
+
+void SecurePool::maxRetained(size_t bytes) {
+    sMaxRetained.store(bytes, std::memory_order_relaxed);
+}
+
+void SecurePool::trim() {
+    if (!tCacheDestroyed)
+        tCache.trim();
+}
+
+/**
+ * memory_resource adapter of SecurePool.
+ */
+class SecurePoolResource : public std::pmr::memory_resource {
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        // memory resources must not return nullptr for 0 bytes
+        bytes = std::max<size_t>(bytes, 1);
+        if (alignment > alignof(std::max_align_t))
+            return ::operator new(bytes, std::align_val_t(alignment));
+
+        return SecurePool::allocate(bytes);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        bytes = std::max<size_t>(bytes, 1);
+        if (alignment > alignof(std::max_align_t)) {
+            MemoryShredder::shred(p, bytes);
+            ::operator delete(p, std::align_val_t(alignment));
+        } else {
+            SecurePool::deallocate(p, bytes);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::pmr::memory_resource *SecurePool::resource() {
+    // never destroyed, so it remains usable by static objects during program exit
+    static auto *resource = new SecurePoolResource();
+    return resource;
+}
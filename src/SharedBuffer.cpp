@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include <secure_memory/SharedBuffer.h>
+#include <secure_memory/helper.h>
+
+// Ranges of SharedBuffers without data refer to this Buffer
+static const Buffer &emptyBuffer() {
+    static const Buffer empty;
+    return empty;
+}
+
+SharedBuffer::SharedBuffer(Buffer &&buffer) : SharedBuffer(std::make_shared<Buffer>(std::move(buffer)), 0, 0) {
+    mSize = mBuffer->size();
+}
+
+SharedBuffer::SharedBuffer(const BufferRangeConst &range) : SharedBuffer(Buffer(range)) { }
+
+SharedBuffer::SharedBuffer(std::shared_ptr<Buffer> buffer, uint32_t offset, uint32_t size)
+        : mBuffer(std::move(buffer)), mOffset(offset), mSize(size) { }
+
+SharedBuffer SharedBuffer::slice(uint32_t offset, uint32_t size) const {
+    offset = std::min(offset, mSize);
+    size = std::min(size, mSize - offset);
+
+    return {mBuffer, mOffset + offset, size};
+}
+
+const void *SharedBuffer::const_data_raw(uint32_t p) const {
+    if (!mBuffer)
+        return nullptr;
+
+    return mBuffer->const_data(mOffset + std::min(p, mSize));
+}
+
+BufferRangeConst SharedBuffer::const_data(uint32_t offset, uint32_t size) const {
+    offset = std::min(offset, mSize);
+    size = std::min(size, mSize - offset);
+
+    if (!mBuffer)
+        return {emptyBuffer(), 0, 0};
+    return {*mBuffer, mOffset + offset, size};
+}
+
+Buffer SharedBuffer::toBuffer() const & {
+    return Buffer(const_data(), mSize);
+}
+
+Buffer SharedBuffer::toBuffer() && {
+    // nobody else can observe the data, so it can be modified
+    if (mBuffer && mBuffer.use_count() == 1) {
+        // use_count() is a relaxed load. Released references decrement with release semantics, so this makes their
+        // owners' reads of the data happen before our modifications.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        Buffer result(std::move(*mBuffer));
+        result.consume(mOffset);
+        result.unuse(result.size() - mSize);
+
+        *this = SharedBuffer();
+        return result;
+    }
+
+    Buffer result = toBuffer();
+    *this = SharedBuffer();
+    return result;
+}
+
+bool SharedBuffer::operator==(const SharedBuffer &other) const {
+    return mSize == other.mSize && comparisonHelper(const_data(), other.const_data(), mSize);
+}
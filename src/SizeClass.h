@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_SIZECLASS_H
+#define SECUREMEMORY_SIZECLASS_H
+
+#include <cstddef>
+
+// smallest size class in bytes, shared by SecurePool and SecureHeap
+static constexpr size_t MIN_SIZE_CLASS = 16;
+
+/**
+ * @return Index of the smallest power of two size class holding size bytes, starting at MIN_SIZE_CLASS
+ */
+static inline size_t sizeClass(size_t size) {
+    if (size <= MIN_SIZE_CLASS)
+        return 0;
+
+    // ceil(log2(size)) - log2(MIN_SIZE_CLASS)
+    return 64 - __builtin_clzll(static_cast<unsigned long long>(size - 1)) - 4;
+}
+
+#endif //SECUREMEMORY_SIZECLASS_H
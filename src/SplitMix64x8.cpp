@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define SM_SUP_X86_DISPATCH 1
+#endif
+
+#include <secure_memory/SplitMix64.h>
+#include <secure_memory/SplitMix64x8.h>
+
+static constexpr uint64_t GAMMA = UINT64_C(0x9e3779b97f4a7c15);
+static constexpr uint64_t MIX1 = UINT64_C(0xbf58476d1ce4e5b9);
+static constexpr uint64_t MIX2 = UINT64_C(0x94d049bb133111eb);
+
+// advances the lanes by count blocks, writing them to data
+using FillBlocks = void (*)(uint64_t *state, uint8_t *data, size_t count);
+
+SM_NO_SANITIZE static void fillScalar(uint64_t *state, uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; i++, data += SplitMix64x8::BLOCK_SIZE) {
+        for (size_t l = 0; l < SplitMix64x8::LANES; l++) {
+            uint64_t z = (state[l] += GAMMA);
+            z = (z ^ (z >> 30u)) * MIX1;
+            z = (z ^ (z >> 27u)) * MIX2;
+            z ^= z >> 31u;
+            memcpy(data + l * sizeof(z), &z, sizeof(z));
+        }
+    }
+}
+
+// advances all lanes by one block, but mixes only the words of the first size bytes
+SM_NO_SANITIZE static void fillPartial(uint64_t *state, uint8_t *data, size_t size) {
+    uint64_t s[SplitMix64x8::LANES];
+    memcpy(s, state, sizeof(s));
+    for (uint64_t &lane : s)
+        lane += GAMMA;
+    memcpy(state, s, sizeof(s));
+
+    for (size_t l = 0; l * sizeof(uint64_t) < size; l++) {
+        uint64_t z = s[l];
+        z = (z ^ (z >> 30u)) * MIX1;
+        z = (z ^ (z >> 27u)) * MIX2;
+        z ^= z >> 31u;
+
+        // whole words are copied without a call to memcpy
+        size_t n = size - l * sizeof(z);
+        if (n >= sizeof(z))
+            memcpy(data + l * sizeof(z), &z, sizeof(z));
+        else
+            memcpy(data + l * sizeof(z), &z, n);
+    }
+}
+
+#ifdef SM_SUP_X86_DISPATCH
+// low 64 bits of a * b, from the 32 bit halves: lo(a) * lo(b) + ((hi(a) * lo(b) + lo(a) * hi(b)) << 32)
+__attribute__((target("avx2")))
+static inline __m256i mul64Avx2(__m256i a, __m256i bLow, __m256i bHigh) {
+    __m256i low = _mm256_mul_epu32(a, bLow);
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), bLow), _mm256_mul_epu32(a, bHigh));
+    return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+static void fillAvx2(uint64_t *state, uint8_t *data, size_t count) {
+    const __m256i gamma = _mm256_set1_epi64x(static_cast<long long>(GAMMA));
+    const __m256i mix1Low = _mm256_set1_epi64x(static_cast<long long>(MIX1 & 0xffffffffu));
+    const __m256i mix1High = _mm256_set1_epi64x(static_cast<long long>(MIX1 >> 32u));
+    const __m256i mix2Low = _mm256_set1_epi64x(static_cast<long long>(MIX2 & 0xffffffffu));
+    const __m256i mix2High = _mm256_set1_epi64x(static_cast<long long>(MIX2 >> 32u));
+    __m256i s[2] = {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(state)),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state) + 1)};
+
+    for (size_t i = 0; i < count; i++, data += SplitMix64x8::BLOCK_SIZE) {
+        for (size_t r = 0; r < 2; r++) {
+            s[r] = _mm256_add_epi64(s[r], gamma);
+            __m256i z = mul64Avx2(_mm256_xor_si256(s[r], _mm256_srli_epi64(s[r], 30)), mix1Low, mix1High);
+            z = mul64Avx2(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), mix2Low, mix2High);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data) + r, _mm256_xor_si256(z, _mm256_srli_epi64(z, 31)));
+        }
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(state), s[0]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(state) + 1, s[1]);
+}
+
+// all lanes in one 512 bit register, the operators map to AVX-512 instructions
+typedef uint64_t Lanes512 __attribute__((vector_size(64)));
+
+__attribute__((target("avx512f,avx512dq")))
+static void fillAvx512(uint64_t *state, uint8_t *data, size_t count) {
+    Lanes512 s;
+    memcpy(&s, state, sizeof(s));
+
+    for (size_t i = 0; i < count; i++, data += SplitMix64x8::BLOCK_SIZE) {
+        s += GAMMA;
+        Lanes512 z = (s ^ (s >> 30u)) * MIX1;
+        z = (z ^ (z >> 27u)) * MIX2;
+        z ^= z >> 31u;
+        memcpy(data, &z, sizeof(z));
+    }
+
+    memcpy(state, &s, sizeof(s));
+}
+#endif
+
+static SplitMix64Isa detectIsa() {
+#ifdef SM_SUP_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+        return SplitMix64Isa::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SplitMix64Isa::AVX2;
+#endif
+    return SplitMix64Isa::Scalar;
+}
+
+static FillBlocks fillFunction(SplitMix64Isa isa) {
+    switch (isa) {
+#ifdef SM_SUP_X86_DISPATCH
+        case SplitMix64Isa::AVX512:
+            return fillAvx512;
+        case SplitMix64Isa::AVX2:
+            return fillAvx2;
+#endif
+        default:
+            return fillScalar;
+    }
+}
+
+// selected instruction set, resolved on first use
+static std::atomic<SplitMix64Isa> &selectedIsa() {
+    static std::atomic<SplitMix64Isa> isa {SplitMix64x8::supportedIsa()};
+    return isa;
+}
+
+SplitMix64x8::SplitMix64x8(uint64_t seed) {
+    SplitMix64 seeder(seed);
+    for (uint64_t &state : mState)
+        state = seeder.next();
+}
+
+void SplitMix64x8::nextBytes(uint8_t *data, size_t size) {
+    size_t count = size / BLOCK_SIZE, remaining = size % BLOCK_SIZE;
+    if (count != 0)
+        fillFunction(isa())(mState, data, count);
+    if (remaining != 0)
+        fillPartial(mState, data + count * BLOCK_SIZE, remaining);
+}
+
+SplitMix64Isa SplitMix64x8::isa() {
+    return selectedIsa().load(std::memory_order_relaxed);
+}
+
+void SplitMix64x8::isa(SplitMix64Isa isa) {
+    selectedIsa().store(std::min(isa, supportedIsa()), std::memory_order_relaxed);
+}
+
+SplitMix64Isa SplitMix64x8::supportedIsa() {
+    static const SplitMix64Isa supported = detectIsa();
+    return supported;
+}
@@ -30,9 +30,13 @@ String::String() : Buffer() { }
 
 String::String(const char *c_str) : Buffer(c_str, strlen_s(c_str)) { }
 
-String::String(const String &other) : Buffer(other.const_data(), other.size()) { }
+String::String(const char *c_str, std::pmr::memory_resource *resource) : Buffer(strlen_s(c_str), resource) {
+    append(c_str, strlen_s(c_str));
+}
 
-String::String(const Buffer &other) : Buffer(other.const_data(), other.size()) { }
+String::String(const String &other) : Buffer(other) { }
+
+String::String(const Buffer &other) : Buffer(other) { }
 
 String String::operator+(const String &other) const {
     return concatHelper(other.const_data(), other.size());
@@ -82,6 +86,11 @@ bool String::operator==(const std::string &other) const {
 }
 
 const char *String::c_str() {
+    // c-strings returned earlier stay valid as long as mCStrings does not reallocate, so reserve a reasonable
+    // capacity up front instead of growing from the empty default state
+    if (mCStrings.capacity() == 0)
+        mCStrings = Buffer(C_STRINGS_RESERVED, resource());
+
     // we need to append a 0-termination char to the string, since it's stored without it internally
     auto range = mCStrings.append(const_data(), size());
     mCStrings.appendValue(0);
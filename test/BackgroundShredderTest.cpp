@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <secure_memory/BackgroundShredder.h>
+#include <secure_memory/Buffer.h>
+#include "BackgroundShredderTest.h"
+
+// size of a block that bypasses the SecurePool cache
+static constexpr size_t LARGE = SecurePool::MAX_BLOCK_SIZE + 1;
+
+TEST_F(BackgroundShredderTest, Disabled) {
+    EXPECT_FALSE(BackgroundShredder::enabled());
+    BackgroundShredder::resetStats();
+
+    // blocks are released synchronously
+    void *data = ::operator new(LARGE);
+    EXPECT_FALSE(BackgroundShredder::defer(data, LARGE, ShredStrategy::Zero));
+    ::operator delete(data);
+    { SecureUniquePtr<uint8_t[]> ptr(LARGE); }
+
+    EXPECT_EQ(0u, BackgroundShredder::stats().deferred);
+    BackgroundShredder::flush();
+}
+
+TEST_F(BackgroundShredderTest, Deferred) {
+    BackgroundShredder::enabled(true);
+    EXPECT_TRUE(BackgroundShredder::enabled());
+    BackgroundShredder::resetStats();
+
+    {
+        Buffer large(4 * 1024 * 1024);
+        large.padd(large.capacity(), 0xAB);
+        SecureUniquePtr<uint8_t[]> ptr(LARGE);
+
+        // small blocks stay with the pool
+        SecureUniquePtr<uint8_t[]> small(100);
+    }
+
+    BackgroundShredder::flush();
+    BackgroundShredderStats stats = BackgroundShredder::stats();
+    EXPECT_EQ(2u, stats.deferred);
+    EXPECT_EQ(0u, stats.synchronous);
+    EXPECT_EQ(0u, stats.pending);
+
+    BackgroundShredder::enabled(false);
+    EXPECT_FALSE(BackgroundShredder::enabled());
+}
+
+TEST_F(BackgroundShredderTest, Limits) {
+    size_t maxQueued = BackgroundShredder::maxQueued(), maxPending = BackgroundShredder::maxPending();
+    BackgroundShredder::enabled(true);
+    BackgroundShredder::resetStats();
+
+    // blocks above the pending limit are shredded synchronously
+    BackgroundShredder::maxPending(LARGE - 1);
+    { SecureUniquePtr<uint8_t[]> ptr(LARGE); }
+    EXPECT_EQ(0u, BackgroundShredder::stats().deferred);
+    EXPECT_EQ(1u, BackgroundShredder::stats().synchronous);
+    BackgroundShredder::maxPending(maxPending);
+    BackgroundShredder::resetStats();
+
+    // a full queue makes releasing threads wait, but never loses blocks
+    BackgroundShredder::maxQueued(0);
+    EXPECT_EQ(1u, BackgroundShredder::maxQueued());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.emplace_back([] {
+            for (int i = 0; i < 16; i++)
+                SecureUniquePtr<uint8_t[]> ptr(LARGE);
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    // stopping drains the queue
+    BackgroundShredder::enabled(false);
+    BackgroundShredderStats stats = BackgroundShredder::stats();
+    EXPECT_EQ(64u, stats.deferred + stats.synchronous);
+    EXPECT_EQ(0u, stats.pending);
+
+    BackgroundShredder::maxQueued(maxQueued);
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SECUREMEMORY_BACKGROUNDSHREDDERTEST_H
+#define SECUREMEMORY_BACKGROUNDSHREDDERTEST_H
+
+
+#include <gtest/gtest.h>
+
+class BackgroundShredderTest : public ::testing::Test {
+
+};
+
+
+
+#endif //SECUREMEMORY_BACKGROUNDSHREDDERTEST_H
@@ -166,3 +166,15 @@ TEST_F(BaseNTest, testBase32) {
     BaseNTestBoth<Base32>(true, "fooba", "MZXW6YTB", true);
     BaseNTestBoth<Base32>(true, "foobar", "MZXW6YTBOI======", true);
 }
+
+TEST_F(BaseNTest, testEncodeTooLarge) {
+    // encoded data beyond the maximum String size is rejected before the input is read
+    uint8_t in = 0;
+    BufferView huge(&in, uint64_t(UINT32_MAX) / 4 * 3 + 3);
+    EXPECT_THROW(Base64::encode(huge), std::length_error);
+    EXPECT_THROW(Hex::encode(BufferView(&in, uint64_t(UINT32_MAX) / 2 + 1)), std::length_error);
+
+    String out("abc");
+    EXPECT_THROW(Base64::encodeTo(huge, out), std::length_error);
+    EXPECT_EQ(String("abc"), out);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/BufferChain.h>
+#include <secure_memory/BufferRange.h>
+#include "BufferChainTest.h"
+#include "custom_assert.h"
+
+TEST_F(BufferChainTest, Append) {
+    BufferChain c(4);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(0u, c.segmentCount());
+
+    c.append("abcdef", 6);
+    EXPECT_EQ(6u, c.size());
+    ASSERT_EQ(2u, c.segmentCount());
+    EXPECT_EQ(4u, c.segment(0).size());
+    EXPECT_EQ(2u, c.segment(1).size());
+
+    // last segment is filled up before a new one is allocated
+    const void *last = c.segment(1).const_data();
+    c.append("ghi", 3);
+    ASSERT_EQ(3u, c.segmentCount());
+    EXPECT_EQ(last, c.segment(1).const_data());
+    EXPECT_EQ(4u, c.segment(1).size());
+    EXPECT_EQ(1u, c.segment(2).size());
+
+    Buffer64 flat = c.flatten();
+    EXPECT_EQ(Buffer("abcdefghi"), flat);
+}
+
+TEST_F(BufferChainTest, AppendSegment) {
+    BufferChain c(4);
+    c.append("ab", 2);
+
+    // adopted heap segments are not copied
+    Buffer segment(std::string(Buffer::INLINE_SIZE + 10, 'x'));
+    const void *data = segment.const_data();
+    c.append(std::move(segment));
+
+    ASSERT_EQ(2u, c.segmentCount());
+    EXPECT_EQ(data, c.segment(1).const_data());
+    EXPECT_EQ(Buffer::INLINE_SIZE + 12, c.size());
+
+    // empty segments are ignored
+    c.append(Buffer());
+    EXPECT_EQ(2u, c.segmentCount());
+    EXPECT_EQ(Buffer("ab" + std::string(Buffer::INLINE_SIZE + 10, 'x')), c.flatten());
+}
+
+TEST_F(BufferChainTest, Consume) {
+    BufferChain c(4);
+    c.append("abcdefghij", 10);
+    ASSERT_EQ(3u, c.segmentCount());
+
+    c.consume(1);
+    EXPECT_EQ(9u, c.size());
+    EXPECT_EQ(3u, c.segmentCount());
+
+    // releases the first segment, consumes the second partially
+    c.consume(5);
+    EXPECT_EQ(4u, c.size());
+    ASSERT_EQ(2u, c.segmentCount());
+    EXPECT_EQ(Buffer("ghij"), c.flatten());
+
+    // consume is limited by size
+    c.consume(100);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(0u, c.segmentCount());
+}
+
+TEST_F(BufferChainTest, Ranges) {
+    BufferChain c(4);
+    c.append("abcdefghij", 10);
+
+    auto ranges = c.const_data(3, 6);
+    ASSERT_EQ(3u, ranges.size());
+    EXPECT_EQ(BufferRangeConst(Buffer("d")), ranges[0]);
+    EXPECT_EQ(BufferRangeConst(Buffer("efgh")), ranges[1]);
+    EXPECT_EQ(BufferRangeConst(Buffer("i")), ranges[2]);
+
+    // limited to the chain's data
+    ranges = c.const_data(8, 100);
+    ASSERT_EQ(1u, ranges.size());
+    EXPECT_EQ(2u, ranges[0].size());
+    EXPECT_TRUE(c.const_data(10, 1).empty());
+
+    char out[10];
+    EXPECT_EQ(5u, c.copyTo(out, 5, 2));
+    EXPECT_ARRAY_EQ(const char, "cdefg", out, 5);
+    EXPECT_EQ(10u, c.copyTo(out, 20));
+    EXPECT_ARRAY_EQ(const char, "abcdefghij", out, 10);
+
+    // appending a Range of a segment
+    BufferChain d(16);
+    d.append(c.const_data(4, 4)[0]);
+    EXPECT_EQ(Buffer("efgh"), d.flatten());
+}
+
+TEST_F(BufferChainTest, Views) {
+    BufferChain c(4);
+    c.append("abcdefghij", 10);
+    c.consume(2);
+
+    auto views = c.views();
+    ASSERT_EQ(3u, views.size());
+    EXPECT_EQ(2u, views[0].size());
+    EXPECT_EQ(4u, views[1].size());
+    EXPECT_EQ(2u, views[2].size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cd", views[0].data(), 2);
+    EXPECT_ARRAY_EQ(const uint8_t, "efgh", views[1].data(), 4);
+    EXPECT_ARRAY_EQ(const uint8_t, "ij", views[2].data(), 2);
+}
+
+TEST_F(BufferChainTest, CopyMove) {
+    BufferChain a(4);
+    a.append("abcdef", 6);
+
+    BufferChain b(a);
+    b.append("gh", 2);
+    EXPECT_EQ(6u, a.size());
+    EXPECT_EQ(Buffer("abcdefgh"), b.flatten());
+
+    BufferChain c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(0u, b.segmentCount());
+    EXPECT_EQ(8u, c.size());
+
+    a = std::move(c);
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(Buffer("abcdefgh"), a.flatten());
+
+    a.clear();
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(0u, a.segmentCount());
+}
@@ -17,12 +17,27 @@
  * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
+#include <memory_resource>
+
 #include <secure_memory/Buffer.h>
 #include <secure_memory/Range.h>
 #include <secure_memory/BufferRange.h>
 #include "BufferTest.h"
 #include "custom_assert.h"
 
+// reallocation statistics are only tracked if built with SECURE_MEMORY_BUFFER_STATS, otherwise they stay 0
+#ifdef SECURE_MEMORY_BUFFER_STATS
+    #define EXPECT_STATS_EQ(expected, actual) EXPECT_EQ(expected, actual)
+#else
+    #define EXPECT_STATS_EQ(expected, actual) EXPECT_EQ(0u, actual)
+#endif
+
 TEST_F(BufferTest, CopyConstructor) {
     Buffer a(20);
     ASSERT_EQ(size_t(0), a.size());
@@ -50,7 +65,8 @@ TEST_F(BufferTest, CopyConstructor) {
 }
 
 TEST_F(BufferTest, MoveConstructor) {
-    Buffer a(20);
+    // heap allocated, so the internal storage is moved
+    Buffer a(Buffer::INLINE_SIZE + 20);
     a.append("abcdefghijkl", 12);
     void *aOldInternal = a.data();
     uint32_t aOldSize = a.size();
@@ -71,7 +87,8 @@ TEST_F(BufferTest, MoveConstructor) {
 }
 
 TEST_F(BufferTest, MoveAssignment) {
-    Buffer a(20);
+    // heap allocated, so the internal storage is moved
+    Buffer a(Buffer::INLINE_SIZE + 20);
     a.append("abcdefghijkl", 12);
     void *aOldInternal = a.data();
     uint32_t aOldSize = a.size();
@@ -965,3 +982,693 @@ TEST_F(BufferTest, SecureFlagEnabled) {
     FAIL() << "Secure UniquePtr is disabled";
 #endif
 }
+
+TEST_F(BufferTest, GrowthPolicy) {
+    {
+        // default: requested size plus twice the capacity
+        Buffer b(10);
+        EXPECT_EQ(BufferGrowth::Triple, b.growthPolicy());
+        b.append("0123456789abcdef", 16);
+        EXPECT_EQ(36u, b.capacity());
+    }
+    {
+        Buffer b(10);
+        b.growthPolicy(BufferGrowth::Double);
+        b.append("0123456789a", 11);
+        EXPECT_EQ(20u, b.capacity());
+        // twice the capacity is less than requested
+        b.append("0123456789abcdefghijklmnopqrstuvwxyz", 36);
+        EXPECT_EQ(47u, b.capacity());
+    }
+    {
+        Buffer b(10);
+        b.growthPolicy(BufferGrowth::OneAndHalf);
+        b.append("0123456789a", 11);
+        EXPECT_EQ(15u, b.capacity());
+    }
+    {
+        Buffer b(10);
+        b.growthPolicy(BufferGrowth::Exact);
+        b.append("0123456789a", 11);
+        EXPECT_EQ(11u, b.capacity());
+        b.append("b", 1);
+        EXPECT_EQ(12u, b.capacity());
+    }
+    {
+        Buffer b(10);
+        b.growthPolicy(BufferGrowth::Page);
+        b.append("0123456789a", 11);
+        EXPECT_LE(11u, b.capacity());
+        EXPECT_EQ(0u, b.capacity() % 512);
+
+        // page policy is preserved by copies
+        Buffer c(b);
+        EXPECT_EQ(BufferGrowth::Page, c.growthPolicy());
+    }
+}
+
+TEST_F(BufferTest, GrowthStats) {
+    Buffer b(40);
+    b.growthPolicy(BufferGrowth::Exact);
+    EXPECT_STATS_EQ(0u, b.stats().reallocations);
+
+    b.append("0123456789012345678901234567890123456789", 40);
+    EXPECT_STATS_EQ(0u, b.stats().reallocations);
+
+    b.append("abcd", 4);
+    b.append("efgh", 4);
+    EXPECT_STATS_EQ(2u, b.stats().reallocations);
+    EXPECT_STATS_EQ(84u, b.stats().bytesCopied);
+    EXPECT_ARRAY_EQ(const uint8_t, "0123456789012345678901234567890123456789abcdefgh", b.const_data(), 48);
+
+    // explicit increase is counted, too
+    b.increase(100);
+    EXPECT_STATS_EQ(3u, b.stats().reallocations);
+    EXPECT_STATS_EQ(132u, b.stats().bytesCopied);
+
+    b.resetStats();
+    EXPECT_STATS_EQ(0u, b.stats().reallocations);
+    EXPECT_STATS_EQ(0u, b.stats().bytesCopied);
+}
+
+TEST_F(BufferTest, InlineStorage) {
+    Buffer a(20);
+    a.append("abcdefghijkl", 12);
+    EXPECT_STATS_EQ(0u, a.stats().reallocations);
+
+    // growing within inline storage does not reallocate
+    a.consume(2);
+    a.increase(Buffer::INLINE_SIZE);
+    EXPECT_STATS_EQ(0u, a.stats().reallocations);
+    EXPECT_EQ(Buffer::INLINE_SIZE, a.capacity());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdefghijkl", a.const_data(), 10);
+
+    // inline storage is copied on move, moved from Buffer is empty and reusable
+    Buffer b(std::move(a));
+    EXPECT_EQ(0u, a.size());
+    EXPECT_EQ(nullptr, a.data());
+    ASSERT_EQ(10u, b.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdefghijkl", b.const_data(), 10);
+    a.append("xyz", 3);
+    EXPECT_ARRAY_EQ(const uint8_t, "xyz", a.const_data(), 3);
+
+    Buffer c;
+    c.append("0123456789", 10);
+    c = std::move(b);
+    ASSERT_EQ(10u, c.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdefghijkl", c.const_data(), 10);
+
+    // exceeding inline storage moves to the heap
+    c.append("0123456789012345678901234567890123456789", 40);
+    EXPECT_STATS_EQ(1u, c.stats().reallocations);
+    ASSERT_EQ(50u, c.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdefghijkl0123456789012345678901234567890123456789", c.const_data(), 50);
+
+    // swap between inline and heap storage
+    secure_memory::swap(a, c);
+    ASSERT_EQ(50u, a.size());
+    ASSERT_EQ(3u, c.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdefghijkl0123456789012345678901234567890123456789", a.const_data(), 50);
+    EXPECT_ARRAY_EQ(const uint8_t, "xyz", c.const_data(), 3);
+}
+
+TEST_F(BufferTest, DeferredAllocation) {
+    // default constructed Buffers do not hold any memory
+    Buffer a;
+    EXPECT_EQ(0u, a.capacity());
+    EXPECT_EQ(nullptr, a.const_data());
+    EXPECT_TRUE(a.empty());
+
+    std::vector<Buffer> buffers;
+    buffers.resize(16);
+    for (auto &b : buffers)
+        EXPECT_EQ(0u, b.capacity());
+
+    // operations on unallocated Buffers are well-defined
+    a.use(10);
+    a.consume(10);
+    a.clear(true);
+    EXPECT_EQ(0u, a.size());
+    Buffer copy(a);
+    EXPECT_EQ(0u, copy.capacity());
+    EXPECT_EQ(a, copy);
+
+    // first write allocates
+    a.append("abc", 3);
+    EXPECT_LE(3u, a.capacity());
+    EXPECT_STATS_EQ(0u, a.stats().reallocations);
+    EXPECT_ARRAY_EQ(const uint8_t, "abc", a.const_data(), 3);
+
+    // moved from Buffers are in the same state
+    Buffer b(std::move(a));
+    EXPECT_EQ(0u, a.capacity());
+    EXPECT_EQ(nullptr, a.const_data());
+    a.append("0123456789012345678901234567890123456789", 40);
+    EXPECT_STATS_EQ(0u, a.stats().reallocations);
+    EXPECT_ARRAY_EQ(const uint8_t, "0123456789012345678901234567890123456789", a.const_data(), 40);
+}
+
+TEST_F(BufferTest, CopyCapacity) {
+    Buffer large(1 << 20);
+    large.padd(1 << 20, 'x');
+    large.consume((1 << 20) - 100);
+    large.compactionThreshold(75);
+
+    // copies are sized to the live data and keep the settings
+    Buffer copy(large);
+    EXPECT_EQ(100u, copy.size());
+    EXPECT_EQ(100u, copy.capacity());
+    EXPECT_EQ(75u, copy.compactionThreshold());
+    EXPECT_EQ(large, copy);
+
+    // configurable slack, inherited by copies
+    large.copySlack(28);
+    Buffer slack(large);
+    EXPECT_EQ(28u, slack.copySlack());
+    EXPECT_EQ(128u, slack.capacity());
+    Buffer slackCopy(slack);
+    EXPECT_EQ(128u, slackCopy.capacity());
+
+    // slack saturates
+    slack.copySlack(UINT32_MAX);
+    EXPECT_EQ(UINT32_MAX, slack.copySlack());
+
+    // copies of empty buffers do not allocate
+    Buffer empty(1000);
+    Buffer emptyCopy(empty);
+    EXPECT_EQ(0u, emptyCopy.capacity());
+    EXPECT_EQ(nullptr, emptyCopy.const_data());
+}
+
+TEST_F(BufferTest, ShrinkToFit) {
+    {
+        // heap storage is reallocated to the size
+        Buffer b(1000);
+        b.padd(200, 'a');
+        b.append("bcd", 3);
+        b.consume(100);
+        b.resetStats();
+        b.shrink_to_fit();
+        EXPECT_EQ(103u, b.capacity());
+        EXPECT_EQ(103u, b.size());
+        EXPECT_STATS_EQ(1u, b.stats().reallocations);
+        EXPECT_STATS_EQ(103u, b.stats().bytesCopied);
+        EXPECT_ARRAY_EQ(const uint8_t, "abcd", b.const_data(99), 4);
+
+        // nothing left to release
+        b.shrink_to_fit();
+        EXPECT_STATS_EQ(1u, b.stats().reallocations);
+
+        // writing grows again
+        b.append("e", 1);
+        EXPECT_EQ(104u, b.size());
+        EXPECT_ARRAY_EQ(const uint8_t, "abcde", b.const_data(99), 5);
+    }
+    {
+        // small data moves to the inline storage
+        Buffer b(1000);
+        b.append("0123456789", 10);
+        b.consume(2);
+        b.shrink_to_fit();
+        EXPECT_EQ(8u, b.capacity());
+        EXPECT_GE(b.const_data(), reinterpret_cast<const uint8_t *>(&b));
+        EXPECT_LT(b.const_data(), reinterpret_cast<const uint8_t *>(&b + 1));
+        EXPECT_ARRAY_EQ(const uint8_t, "23456789", b.const_data(), 8);
+        b.append("abc", 3);
+        EXPECT_ARRAY_EQ(const uint8_t, "23456789abc", b.const_data(), 11);
+    }
+    {
+        // empty buffers release their allocation
+        Buffer b(1000);
+        b.append("abc", 3);
+        b.consume(3);
+        b.shrink_to_fit();
+        EXPECT_EQ(0u, b.capacity());
+        EXPECT_EQ(nullptr, b.const_data());
+        b.append("abc", 3);
+        EXPECT_EQ(Buffer("abc"), b);
+
+        // inline storage is left alone
+        b.shrink_to_fit();
+        EXPECT_EQ(Buffer("abc"), b);
+    }
+}
+
+TEST_F(BufferTest, PrepareCommit) {
+    Buffer b;
+    b.append("abc", 3);
+
+    // prepared bytes are writable, but not used
+    MutableBufferView view = b.prepare(100);
+    ASSERT_EQ(100u, view.size());
+    EXPECT_GE(b.capacity(), 103u);
+    EXPECT_EQ(3u, b.size());
+    memcpy(view.data(), "defgh", 5);
+
+    // committing appends them
+    b.commit(5);
+    EXPECT_EQ(Buffer("abcdefgh"), b);
+
+    // prepare keeps the used bytes and works after consuming
+    b.consume(2);
+    view = b.prepare(2);
+    ASSERT_EQ(2u, view.size());
+    memcpy(view.data(), "ij", 2);
+    b.commit(2);
+    EXPECT_EQ(Buffer("cdefghij"), b);
+
+    // commits are limited to the capacity
+    b.commit(b.capacity());
+    EXPECT_EQ(b.capacity(), b.size());
+
+    // nothing to prepare
+    Buffer empty;
+    EXPECT_EQ(0u, empty.prepare(0).size());
+    empty.commit(0);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST_F(BufferTest, AdoptRelease) {
+    // adopting keeps the array
+    SecureUniquePtr<uint8_t[]> data(100);
+    memcpy(data().get(), "abcdef", 6);
+    const uint8_t *raw = data().get();
+
+    Buffer b(std::move(data), 6);
+    EXPECT_EQ(nullptr, data().get());
+    EXPECT_EQ(raw, b.const_data());
+    EXPECT_EQ(100u, b.capacity());
+    EXPECT_EQ(Buffer("abcdef"), b);
+
+    // used bytes are limited to the array
+    Buffer full(SecureUniquePtr<uint8_t[]>(10), 20);
+    EXPECT_EQ(10u, full.size());
+    Buffer empty(SecureUniquePtr<uint8_t[]>(), 20);
+    EXPECT_TRUE(empty.empty());
+    empty.append("x", 1);
+    EXPECT_EQ(Buffer("x"), empty);
+
+    // releasing moves the used bytes to the front without reallocating
+    b.consume(2);
+    uint32_t used = b.size();
+    SecureUniquePtr<uint8_t[]> released = b.release();
+    EXPECT_EQ(raw, released().get());
+    EXPECT_EQ(100u, released.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdef", released().get(), used);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(0u, b.capacity());
+    b.append("ghi", 3);
+    EXPECT_EQ(Buffer("ghi"), b);
+
+    // the round trip keeps the array
+    Buffer back(std::move(released), used);
+    EXPECT_EQ(raw, back.const_data());
+    EXPECT_EQ(Buffer("cdef"), back);
+
+    // small buffers copy their inline data into a new array
+    SecureUniquePtr<uint8_t[]> small = b.release();
+    EXPECT_EQ(3u, small.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "ghi", small().get(), 3);
+    EXPECT_EQ(nullptr, Buffer().release()().get());
+}
+
+TEST_F(BufferTest, Compaction) {
+    {
+        // consumed bytes exceed threshold -> compact instead of reallocating
+        Buffer b(64);
+        b.append("0123456789012345678901234567890123456789012345678901234567890123", 64);
+        b.consume(40);
+        b.append("abcdefghijklmnopqrstuvwxyz0123", 30);
+        EXPECT_STATS_EQ(0u, b.stats().reallocations);
+        EXPECT_STATS_EQ(1u, b.stats().compactions);
+        EXPECT_STATS_EQ(24u, b.stats().bytesMoved);
+        EXPECT_EQ(64u, b.capacity());
+        ASSERT_EQ(54u, b.size());
+        EXPECT_ARRAY_EQ(const uint8_t, "012345678901234567890123abcdefghijklmnopqrstuvwxyz0123", b.const_data(), 54);
+    }
+    {
+        // consumed bytes below threshold -> reallocate
+        Buffer b(64);
+        b.append("0123456789012345678901234567890123456789012345678901234567890123", 64);
+        b.consume(20);
+        b.append("abcdefghij", 10);
+        EXPECT_STATS_EQ(1u, b.stats().reallocations);
+        EXPECT_STATS_EQ(0u, b.stats().compactions);
+        ASSERT_EQ(54u, b.size());
+        EXPECT_ARRAY_EQ(const uint8_t, "01234567890123456789012345678901234567890123abcdefghij", b.const_data(), 54);
+    }
+    {
+        // lower threshold, compaction by explicit increase
+        Buffer b(64);
+        b.compactionThreshold(25);
+        b.append("0123456789012345678901234567890123456789012345678901234567890123", 64);
+        b.consume(20);
+        EXPECT_EQ(64u, b.increase(60));
+        EXPECT_STATS_EQ(0u, b.stats().reallocations);
+        EXPECT_STATS_EQ(1u, b.stats().compactions);
+        EXPECT_ARRAY_EQ(const uint8_t, "01234567890123456789012345678901234567890123", b.const_data(), 44);
+    }
+    {
+        // disabled compaction still compacts empty buffers
+        Buffer b(64);
+        b.compactionThreshold(101);
+        b.growthPolicy(BufferGrowth::Exact);
+        b.append("0123456789012345678901234567890123456789012345678901234567890123", 64);
+        b.consume(63);
+        b.append("a", 1);
+        EXPECT_STATS_EQ(1u, b.stats().reallocations);
+        EXPECT_EQ(2u, b.capacity());
+
+        b.consume(b.size());
+        b.append("bc", 2);
+        EXPECT_STATS_EQ(1u, b.stats().reallocations);
+        EXPECT_STATS_EQ(1u, b.stats().compactions);
+        EXPECT_ARRAY_EQ(const uint8_t, "bc", b.const_data(), 2);
+    }
+}
+
+TEST_F(BufferTest, Buffer64) {
+    uint64_t large = uint64_t(std::numeric_limits<uint32_t>::max()) + 16;
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), Buffer64Range::OBJ_END);
+
+    Buffer64 a;
+    a.append("abcdef", 6);
+    a.consume(2);
+    EXPECT_EQ(4u, a.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdef", a.const_data(), 4);
+
+    // offsets and sizes beyond 32 bits are clamped to the Buffer, not truncated
+    a.consume(large);
+    EXPECT_TRUE(a.empty());
+    a.append("abcdef", 6);
+    EXPECT_EQ(2u, a.const_data(4, large).size());
+    EXPECT_EQ(a.const_data(6), a.const_data(large));
+
+    Buffer64Range full(a);
+    full += 2;
+    EXPECT_EQ(4u, full.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "cdef", full.const_data(), 4);
+
+    // size prefix has 64 bits
+    Buffer64 serialized, b;
+    a.serializeAppend(serialized);
+    EXPECT_EQ(sizeof(uint64_t) + 6, serialized.size());
+    EXPECT_TRUE(b.deserializeFrom(serialized));
+    EXPECT_EQ(a, b);
+
+    std::hash<const Buffer64> hasher;
+    EXPECT_EQ(hasher(a), hasher(b));
+    EXPECT_EQ(std::hash<const Buffer>()(Buffer("abcdef")), hasher(a));
+}
+
+#ifndef _WIN32
+TEST_F(BufferTest, FileDescriptorIO) {
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+
+    Buffer out("abcdefgh");
+    EXPECT_EQ(8, out.writeTo(fds[1]));
+    EXPECT_TRUE(out.empty());
+
+    // reads append behind the used bytes, limited by max
+    Buffer in;
+    in.append("xy", 2);
+    EXPECT_EQ(3, in.readFrom(fds[0], 3));
+    EXPECT_EQ(Buffer("xyabc"), in);
+    EXPECT_EQ(5, in.readFrom(fds[0], 100));
+    EXPECT_EQ(Buffer("xyabcdefgh"), in);
+
+    // empty reads fail instead of reporting end of file
+    errno = 0;
+    EXPECT_EQ(-1, in.readFrom(fds[0], 0));
+    EXPECT_EQ(EINVAL, errno);
+    EXPECT_EQ(Buffer("xyabcdefgh"), in);
+
+    // gather write consumes from all Buffers, skipping empty ones
+    Buffer a("0123"), b("45"), c;
+    Buffer *gather[] = {&a, &c, &b};
+    EXPECT_EQ(6, Buffer::writeTo(fds[1], gather, 3));
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(b.empty());
+
+    // scatter read fills the free capacity of the Buffers in order
+    Buffer d(4), e(8);
+    d.append("d", 1);
+    Buffer *scatter[] = {&d, &e};
+    EXPECT_EQ(6, Buffer::readFrom(fds[0], scatter, 2));
+    EXPECT_EQ(Buffer("d012"), d);
+    EXPECT_EQ(Buffer("345"), e);
+
+    // partial write into a full non-blocking pipe leaves the remaining bytes
+    ASSERT_EQ(0, fcntl(fds[1], F_SETFL, O_NONBLOCK));
+    Buffer large(1 << 24);
+    large.padd(1 << 24, 0);
+    ssize_t written = large.writeTo(fds[1]);
+    ASSERT_GT(written, 0);
+    EXPECT_EQ(static_cast<uint32_t>((1 << 24) - written), large.size());
+
+    // end of file
+    close(fds[1]);
+    Buffer drain;
+    while (drain.readFrom(fds[0], 1 << 16) > 0)
+        drain.clear();
+    EXPECT_EQ(0, drain.readFrom(fds[0], 16));
+    close(fds[0]);
+}
+#endif
+
+// memory resource counting allocations from a monotonic arena, which keeps released memory readable
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    uint8_t arena[4096] = {};
+    std::pmr::monotonic_buffer_resource upstream {arena, sizeof(arena), std::pmr::null_memory_resource()};
+    uint32_t allocations = 0, deallocations = 0;
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        allocations++;
+        return upstream.allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        deallocations++;
+        upstream.deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST_F(BufferTest, MemoryResource) {
+    ArenaResource arena;
+    const uint8_t *begin = arena.arena, *end = arena.arena + sizeof(arena.arena);
+    const uint8_t secret[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJ";
+    const uint8_t *released;
+
+    {
+        // inline and deferred Buffers do not allocate
+        Buffer a(0, &arena);
+        EXPECT_EQ(&arena, a.resource());
+        a.append(secret, 10);
+        EXPECT_EQ(0u, arena.allocations);
+
+        // growing allocates from the resource
+        a.append(secret + 10, sizeof(secret) - 10);
+        EXPECT_EQ(1u, arena.allocations);
+        EXPECT_GE(a.const_data(), begin);
+        EXPECT_LT(a.const_data(), end);
+        released = a.const_data();
+
+        // copies keep the resource unless another one is given
+        Buffer arenaCopy(a);
+        EXPECT_EQ(&arena, arenaCopy.resource());
+        EXPECT_EQ(a, arenaCopy);
+        Buffer copy(a, nullptr);
+        EXPECT_EQ(nullptr, copy.resource());
+        EXPECT_EQ(a, copy);
+        EXPECT_EQ(2u, arena.allocations);
+
+        // moves keep memory and resource
+        Buffer moved(std::move(a));
+        EXPECT_EQ(&arena, moved.resource());
+        EXPECT_EQ(&arena, a.resource());
+        EXPECT_EQ(released, moved.const_data());
+        // the replaced default memory does not go to the arena
+        copy = std::move(moved);
+        EXPECT_EQ(&arena, copy.resource());
+        EXPECT_EQ(0u, arena.deallocations);
+    }
+
+    EXPECT_EQ(2u, arena.deallocations);
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+    // memory is shredded before it is returned to the resource
+    EXPECT_FALSE(memcmp(released, secret, sizeof(secret)) == 0);
+#endif
+
+    // SecureUniquePtr directly
+    SecureUniquePtr<uint8_t[]> ptr(100, &arena);
+    EXPECT_EQ(&arena, ptr.resource());
+    EXPECT_EQ(100u, ptr.size());
+    SecureUniquePtr<uint8_t[]> defaultPtr(100, nullptr);
+    EXPECT_EQ(nullptr, defaultPtr.resource());
+}
+
+TEST_F(BufferTest, CopySecureHeap) {
+    // copies of locked Buffers stay in locked memory, small ones included
+    Buffer b(0, SecureHeap::resource());
+    b.append("secret", 6);
+    size_t used = SecureHeap::stats().used;
+
+    Buffer copy(b);
+    EXPECT_EQ(SecureHeap::resource(), copy.resource());
+    EXPECT_EQ(b, copy);
+    EXPECT_GT(SecureHeap::stats().used, used);
+
+    Buffer64 b64(0, SecureHeap::resource());
+    b64.append("secret", 6);
+    Buffer64 copy64(b64);
+    EXPECT_EQ(SecureHeap::resource(), copy64.resource());
+}
+
+TEST_F(BufferTest, Footprint) {
+#ifndef SECURE_MEMORY_BUFFER_STATS
+    // the allocation's deleter holds capacity, dirty mark, resource and strategy, nothing is stored twice
+    EXPECT_LE(sizeof(Buffer), 96u);
+    EXPECT_LE(sizeof(Buffer64), 104u);
+#endif
+}
+
+TEST_F(BufferTest, ShredStrategy) {
+    Buffer b;
+    EXPECT_EQ(MemoryShredder::DEFAULT_STRATEGY, b.shredStrategy());
+    b.shredStrategy(ShredStrategy::Pattern);
+    b.append("abcdef", 6);
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+    // clearing inline storage uses the strategy
+    const uint8_t *raw = b.const_data();
+    b.clear(true);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[0]);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[5]);
+    b.append("abcdef", 6);
+#endif
+
+    // heap allocations, copies and moves keep the strategy
+    b.increase(1000);
+    Buffer copy(b);
+    EXPECT_EQ(ShredStrategy::Pattern, copy.shredStrategy());
+    Buffer moved(std::move(copy));
+    EXPECT_EQ(ShredStrategy::Pattern, moved.shredStrategy());
+    Buffer assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(ShredStrategy::Pattern, assigned.shredStrategy());
+
+    // the strategy is handed out with the array and adopted back
+    SecureUniquePtr<uint8_t[]> released = assigned.release();
+    EXPECT_EQ(ShredStrategy::Pattern, released.shredStrategy());
+    released.shredStrategy(ShredStrategy::Zero);
+    Buffer adopted(std::move(released), 6);
+    EXPECT_EQ(ShredStrategy::Zero, adopted.shredStrategy());
+
+    // changing the strategy affects the current allocation
+    adopted.shredStrategy(ShredStrategy::CSPRNG);
+    EXPECT_EQ(ShredStrategy::CSPRNG, adopted.release().shredStrategy());
+}
+
+TEST_F(BufferTest, DirtyHighWaterMark) {
+    // only written bytes are handed out as dirty
+    Buffer b(1000);
+    b.append("abcdef", 6);
+    b.consume(2);
+    SecureUniquePtr<uint8_t[]> released = b.release();
+    EXPECT_EQ(1000u, released.size());
+    EXPECT_EQ(6u, released.dirty());
+
+    // the mark survives a round trip, prepared bytes count as written
+    Buffer adopted(std::move(released), 4);
+    adopted.prepare(10);
+    EXPECT_EQ(14u, adopted.release().dirty());
+
+    // shredding resets the mark
+    Buffer cleared(1000);
+    cleared.append("abcdef", 6);
+    cleared.clear(true);
+    EXPECT_EQ(0u, cleared.release().dirty());
+
+    // reallocations and copies start with the used bytes
+    Buffer grown;
+    grown.append("abcdef", 6);
+    grown.increase(1000);
+    EXPECT_EQ(6u, Buffer(grown).release().dirty());
+    grown.write("x", 1, 99);
+    EXPECT_EQ(100u, grown.release().dirty());
+
+    // mutable pointers may write to the free capacity, which is thus dirty even if it is never used
+    Buffer slack(1000);
+    slack.append("abc", 3);
+    memcpy(slack.data(slack.size()), "defg", 4);
+    slack.use(1);
+    EXPECT_EQ(1000u, slack.release().dirty());
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+    // untouched bytes are left alone
+    Buffer partial(1000);
+    partial.shredStrategy(ShredStrategy::Pattern);
+    auto *raw = const_cast<uint8_t *>(partial.const_data());
+    memset(raw, 0x11, 1000);
+    partial.append("abcdef", 6);
+    partial.clear(true);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[5]);
+    EXPECT_EQ(0x11, raw[6]);
+
+    // bytes written behind the used ones are shredded as well
+    Buffer unused(1000);
+    unused.shredStrategy(ShredStrategy::Pattern);
+    raw = unused.data();
+    memset(raw, 0x11, 50);
+    unused.use(10);
+    unused.clear(true);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[9]);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[49]);
+#endif
+}
+
+TEST_F(BufferTest, PageBacked) {
+    // small Buffers do not use pages
+    Buffer small(1000);
+    EXPECT_NE(SecurePages::resource(), small.release().resource());
+
+    Buffer b(SecurePages::MIN_SIZE);
+    for (uint32_t i = 0; i < SecurePages::MIN_SIZE / 4; i++)
+        b.append(&i, 4);
+    b.consume(4);
+
+#ifdef __linux__
+    // growth remaps the pages, the consumed bytes stay in front
+    b.increase(SecurePages::MIN_SIZE * 8);
+    EXPECT_STATS_EQ(1u, b.stats().reallocations);
+    EXPECT_STATS_EQ(0u, b.stats().bytesCopied);
+    EXPECT_STATS_EQ(0u, b.stats().bytesMoved);
+    EXPECT_GE(b.capacity(), SecurePages::MIN_SIZE * 8);
+#endif
+
+    uint32_t value;
+    memcpy(&value, b.const_data(), 4);
+    EXPECT_EQ(1u, value);
+    memcpy(&value, b.const_data(b.size() - 4), 4);
+    EXPECT_EQ(SecurePages::MIN_SIZE / 4 - 1, value);
+
+    // pages are handed out and adopted back as they are
+    SecureUniquePtr<uint8_t[]> released = b.release();
+    EXPECT_EQ(SecurePages::resource(), released.resource());
+    Buffer adopted(std::move(released), 10);
+    EXPECT_EQ(nullptr, adopted.resource());
+    adopted.increase(SecurePages::MIN_SIZE * 16);
+    EXPECT_EQ(10u, adopted.size());
+
+#if defined(__linux__) && defined(SECURE_MEMORY_UNIQUE_PTR_SHRED)
+    // shredding page backed storage discards the pages
+    const uint8_t *raw = adopted.const_data();
+    adopted.clear(true);
+    EXPECT_EQ(0, raw[SecurePages::MIN_SIZE / 2]);
+#endif
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <unordered_set>
+
+#include <secure_memory/BufferView.h>
+#include <secure_memory/BaseN.h>
+#include <secure_memory/SharedBuffer.h>
+#include "BufferViewTest.h"
+#include "custom_assert.h"
+
+TEST_F(BufferViewTest, Conversions) {
+    // strings are viewed in place, std::string converts explicitly through std::string_view
+    std::string str = "abcdef";
+    BufferView view(str);
+    EXPECT_EQ(reinterpret_cast<const uint8_t *>(str.data()), view.data());
+    EXPECT_EQ(6u, view.size());
+
+    std::string_view sv = "xyz";
+    BufferView svView = sv;
+    EXPECT_EQ(3u, svView.size());
+
+    // mutable views convert to read-only ones
+    uint8_t bytes[] = {1, 2, 3};
+    MutableBufferView mutableView(bytes, sizeof(bytes));
+    BufferView constView = mutableView;
+    EXPECT_EQ(bytes, constView.data());
+    EXPECT_EQ(BufferView(bytes, 2), constView.subview(0, 2));
+
+    // owning types provide views
+    Buffer buffer("abcdef");
+    EXPECT_EQ(buffer.const_data(), buffer.view().data());
+    EXPECT_EQ(6u, buffer.view().size());
+    EXPECT_EQ(buffer.const_data(2), buffer.const_data(2, 3).view().data());
+    EXPECT_EQ(3u, buffer.const_data(2, 3).view().size());
+    SharedBuffer shared(Buffer("abcdef"));
+    EXPECT_EQ(shared.const_data(), shared.view().data());
+}
+
+TEST_F(BufferViewTest, Comparison) {
+    std::string str = "abcdef";
+    Buffer buffer("abcdef");
+
+    EXPECT_TRUE(BufferView(str) == buffer.view());
+    EXPECT_TRUE(buffer == BufferView(str));
+    EXPECT_TRUE(buffer == std::string_view("abcdef"));
+    EXPECT_TRUE(buffer != std::string_view("abcdeg"));
+    EXPECT_TRUE(buffer != std::string_view("abcde"));
+    EXPECT_TRUE(String("abc") == std::string_view("abc"));
+
+    EXPECT_TRUE(BufferView(std::string_view("abc")) < BufferView(std::string_view("abd")));
+    EXPECT_TRUE(BufferView(std::string_view("ab")) < BufferView(std::string_view("abc")));
+    EXPECT_FALSE(BufferView(std::string_view("abc")) < BufferView(std::string_view("abc")));
+    EXPECT_TRUE(BufferView() == BufferView(std::string_view("")));
+}
+
+TEST_F(BufferViewTest, Hash) {
+    Buffer buffer("hash me");
+    std::string str = "hash me";
+
+    // views hash like Buffers and Ranges of the same data
+    size_t hash = std::hash<BufferView>()(BufferView(str));
+    EXPECT_EQ(std::hash<const Buffer>()(buffer), hash);
+    EXPECT_EQ(std::hash<const BufferRangeConst>()(buffer.const_data(0, 7)), hash);
+    EXPECT_NE(std::hash<BufferView>()(std::string_view("hash mf")), hash);
+
+    std::unordered_set<BufferView> set;
+    set.insert(BufferView(str));
+    EXPECT_EQ(1u, set.count(buffer.view()));
+}
+
+TEST_F(BufferViewTest, InPlace) {
+    std::string str = "some text";
+
+    // append and construct from raw memory without an intermediate Buffer
+    Buffer buffer;
+    buffer.append(BufferView(str));
+    buffer.append(std::string_view("!"));
+    EXPECT_EQ(Buffer("some text!"), buffer);
+    EXPECT_EQ(Buffer("some text"), Buffer(BufferView(str)));
+
+    // BaseN processes views in place
+    EXPECT_EQ(String("c29tZSB0ZXh0"), BaseN::Base64::encode(BufferView(str)));
+    Buffer decoded;
+    EXPECT_TRUE(BaseN::Base64::decodeFrom(std::string_view("c29tZSB0ZXh0"), decoded));
+    EXPECT_EQ(Buffer("some text"), decoded);
+    EXPECT_FALSE(BaseN::Base64::decodeFrom(std::string_view("c29t!"), decoded, true));
+    EXPECT_EQ("736F6D652074657874", BaseN::Base16::encodeString(str));
+    EXPECT_EQ(str, BaseN::Base16::decodeString("736F6D652074657874"));
+}
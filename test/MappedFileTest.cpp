@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WIN32
+
+#include <unistd.h>
+
+#include <secure_memory/MappedFile.h>
+#include <secure_memory/BaseN.h>
+#include <secure_memory/Buffer.h>
+#include "MappedFileTest.h"
+#include "custom_assert.h"
+
+// creates a temporary file with the given contents, returns its path
+static std::string tempFile(const Buffer &contents) {
+    char path[] = "/tmp/secure_memory_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return {};
+
+    Buffer copy(contents);
+    while (!copy.empty() && copy.writeTo(fd) > 0);
+    close(fd);
+    return path;
+}
+
+// reads a whole file into a Buffer
+static Buffer readFile(const std::string &path) {
+    Buffer result;
+    MappedFile file(path);
+    result.append(file.const_data(), static_cast<uint32_t>(file.size()));
+    return result;
+}
+
+TEST_F(MappedFileTest, ReadOnly) {
+    std::string path = tempFile(Buffer("abcdefghij"));
+    ASSERT_FALSE(path.empty());
+
+    MappedFile file(path);
+    ASSERT_TRUE(file.isMapped());
+    EXPECT_EQ(MappedFile::Mode::ReadOnly, file.mode());
+    EXPECT_EQ(10u, file.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "abcdefghij", file.const_data(), 10);
+    EXPECT_EQ('d', *file.const_data<char>(3));
+
+    // Ranges work on top of the mapping and are limited to it
+    MappedFileRangeConst range = file.const_data(6, 100);
+    EXPECT_EQ(4u, range.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "ghij", range.const_data(), 4);
+    range += 2;
+    EXPECT_ARRAY_EQ(const uint8_t, "ij", range.const_data(), 2);
+    EXPECT_EQ(10u, MappedFileRangeConst(file).size());
+
+    BufferView view = file.view();
+    EXPECT_EQ(10u, view.size());
+    EXPECT_EQ(file.const_data(), view.data());
+
+    // views of parts of the mapping are processed in place
+    BufferView part = file.view(6, 100);
+    EXPECT_EQ(4u, part.size());
+    EXPECT_EQ(file.const_data(6), part.data());
+    EXPECT_EQ(String("Z2hpag=="), BaseN::Base64::encode(part));
+    Buffer appended;
+    appended.append(file.const_data(2, 3).view());
+    EXPECT_EQ(Buffer("cde"), appended);
+
+    // no mutable access
+    EXPECT_EQ(nullptr, file.data());
+    file.write("x", 1);
+    EXPECT_EQ('a', *file.const_data<char>());
+
+    file.unmap();
+    EXPECT_FALSE(file.isMapped());
+    EXPECT_TRUE(file.empty());
+    unlink(path.c_str());
+}
+
+TEST_F(MappedFileTest, Private) {
+    std::string path = tempFile(Buffer("abcdefghij"));
+    ASSERT_FALSE(path.empty());
+
+    {
+        MappedFile file(path, MappedFile::Mode::Private);
+        ASSERT_TRUE(file.isMapped());
+
+        file.write("XY", 2, 1);
+        file.data<char>(9)[0] = 'Z';
+        MappedFileRange range = file.data(4, 2);
+        range.write("01", 2);
+        EXPECT_ARRAY_EQ(const uint8_t, "aXYd01ghiZ", file.const_data(), 10);
+
+        // writes are limited to the mapping
+        file.write("12345", 5, 8);
+        EXPECT_ARRAY_EQ(const uint8_t, "aXYd01gh12", file.const_data(), 10);
+    }
+
+    // modifications never reach the file
+    EXPECT_EQ(Buffer("abcdefghij"), readFile(path));
+    unlink(path.c_str());
+}
+
+TEST_F(MappedFileTest, DirtyPages) {
+    auto page = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    std::string path = tempFile(Buffer(std::string(16 * page, 'a')));
+    ASSERT_FALSE(path.empty());
+
+    MappedFile file(path, MappedFile::Mode::Private);
+    ASSERT_TRUE(file.isMapped());
+    EXPECT_FALSE(file.isDirty(0));
+
+    // two distant writes do not mark the pages between them
+    file.write("X", 1, 1);
+    file.write("Y", 1, 15 * page + 10);
+    EXPECT_TRUE(file.isDirty(0));
+    EXPECT_TRUE(file.isDirty(16 * page - 1));
+    for (uint32_t i = 1; i < 15; i++)
+        EXPECT_FALSE(file.isDirty(i * page));
+
+    // a write across a page boundary marks both pages
+    file.write("01", 2, 4 * page - 1);
+    EXPECT_TRUE(file.isDirty(3 * page));
+    EXPECT_TRUE(file.isDirty(4 * page));
+    EXPECT_FALSE(file.isDirty(5 * page));
+
+    // a mutable pointer marks everything up to the end
+    file.data<char>(10 * page)[0] = 'Z';
+    EXPECT_FALSE(file.isDirty(9 * page));
+    EXPECT_TRUE(file.isDirty(12 * page));
+
+    file.unmap();
+    EXPECT_FALSE(file.isDirty(0));
+    EXPECT_EQ(Buffer(std::string(16 * page, 'a')), readFile(path));
+    unlink(path.c_str());
+}
+
+TEST_F(MappedFileTest, Move) {
+    std::string path = tempFile(Buffer("abcdef"));
+    ASSERT_FALSE(path.empty());
+
+    MappedFile a(path, MappedFile::Mode::Private);
+    a.write("X", 1);
+
+    MappedFile b(std::move(a));
+    EXPECT_FALSE(a.isMapped());
+    EXPECT_TRUE(b.isMapped());
+    EXPECT_ARRAY_EQ(const uint8_t, "Xbcdef", b.const_data(), 6);
+
+    MappedFile c;
+    c = std::move(b);
+    EXPECT_FALSE(b.isMapped());
+    EXPECT_EQ(6u, c.size());
+    unlink(path.c_str());
+}
+
+TEST_F(MappedFileTest, Errors) {
+    MappedFile missing("/nonexistent/secure_memory");
+    EXPECT_FALSE(missing.isMapped());
+    EXPECT_EQ(0u, missing.size());
+
+    // empty files are mapped without memory
+    std::string path = tempFile(Buffer());
+    ASSERT_FALSE(path.empty());
+
+    MappedFile empty;
+    EXPECT_TRUE(empty.map(path));
+    EXPECT_TRUE(empty.isMapped());
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0u, empty.const_data(0, 10).size());
+    unlink(path.c_str());
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include <secure_memory/MemoryShredder.h>
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include "MemoryShredderTest.h"
+
+// number of bytes equal to value
+static size_t countBytes(const uint8_t *data, size_t size, uint8_t value) {
+    return static_cast<size_t>(std::count(data, data + size, value));
+}
+
+TEST_F(MemoryShredderTest, Strategies) {
+    uint8_t data[256];
+
+    memset(data, 0x11, sizeof(data));
+    MemoryShredder::shred(data, sizeof(data), ShredStrategy::Zero);
+    EXPECT_EQ(sizeof(data), countBytes(data, sizeof(data), 0));
+
+    memset(data, 0x11, sizeof(data));
+    MemoryShredder::shred(data, sizeof(data), ShredStrategy::Pattern);
+    EXPECT_EQ(sizeof(data), countBytes(data, sizeof(data), MemoryShredder::PATTERN));
+
+    // random bytes leave few of the old ones, and differ between calls
+    for (ShredStrategy strategy : {ShredStrategy::PRNG, ShredStrategy::CSPRNG}) {
+        uint8_t other[sizeof(data)];
+        memset(data, 0x11, sizeof(data));
+        MemoryShredder::shred(data, sizeof(data), strategy);
+        EXPECT_GT(16u, countBytes(data, sizeof(data), 0x11));
+
+        memcpy(other, data, sizeof(data));
+        MemoryShredder::shred(data, sizeof(data), strategy);
+        EXPECT_NE(0, memcmp(other, data, sizeof(data)));
+    }
+
+    // odd sizes and nullptr
+    memset(data, 0x11, sizeof(data));
+    MemoryShredder::shred(data + 1, 5, ShredStrategy::CSPRNG);
+    EXPECT_EQ(0x11, data[0]);
+    EXPECT_EQ(0x11, data[6]);
+    MemoryShredder::shred(nullptr, 10, ShredStrategy::CSPRNG);
+}
+
+TEST_F(MemoryShredderTest, NonTemporal) {
+    size_t size = MemoryShredder::NON_TEMPORAL_MIN_SIZE + 64;
+    std::unique_ptr<uint8_t[]> data(new uint8_t[size]);
+
+    // unaligned ranges, streamed in the middle and written through the cache at the edges
+    for (ShredStrategy strategy : {ShredStrategy::Zero, ShredStrategy::Pattern, ShredStrategy::PRNG,
+                                   ShredStrategy::CSPRNG}) {
+        memset(data.get(), 0x11, size);
+        MemoryShredder::shred(data.get() + 3, size - 8, strategy);
+        EXPECT_EQ(0x11, data[2]);
+        EXPECT_EQ(0x11, data[size - 5]);
+
+        if (strategy == ShredStrategy::Zero)
+            EXPECT_EQ(size - 8, countBytes(data.get() + 3, size - 8, 0));
+        else if (strategy == ShredStrategy::Pattern)
+            EXPECT_EQ(size - 8, countBytes(data.get() + 3, size - 8, MemoryShredder::PATTERN));
+        else
+            EXPECT_GT(size / 64, countBytes(data.get() + 3, size - 8, 0x11));
+    }
+}
+
+TEST_F(MemoryShredderTest, Discard) {
+    size_t size = MemoryShredder::DISCARD_MIN_SIZE * 2;
+    auto *data = static_cast<uint8_t *>(SecurePages::allocate(size));
+    memset(data, 0x11, size);
+
+    // unaligned ranges: whole pages read as zeros or pattern, the edges use the strategy
+    MemoryShredder::discard(data + 100, size - 200, ShredStrategy::Pattern);
+    EXPECT_EQ(0x11, data[99]);
+    EXPECT_EQ(MemoryShredder::PATTERN, data[100]);
+    EXPECT_EQ(MemoryShredder::PATTERN, data[size - 101]);
+    EXPECT_EQ(0x11, data[size - 100]);
+    EXPECT_EQ(0u, countBytes(data + 100, size - 200, 0x11));
+
+    // small ranges are overwritten
+    memset(data, 0x11, size);
+    MemoryShredder::discard(data, 1000, ShredStrategy::Pattern);
+    EXPECT_EQ(1000u, countBytes(data, 1000, MemoryShredder::PATTERN));
+    MemoryShredder::discard(nullptr, size, ShredStrategy::Pattern);
+
+    SecurePages::deallocate(data, size);
+}
+
+TEST_F(MemoryShredderTest, Arrays) {
+    SecureUniquePtr<uint8_t[]> data(100);
+    EXPECT_EQ(MemoryShredder::DEFAULT_STRATEGY, data.shredStrategy());
+
+    // all elements are dirty unless lowered
+    EXPECT_EQ(100u, data.dirty());
+    data.dirty(200);
+    EXPECT_EQ(100u, data.dirty());
+
+    data.shredStrategy(ShredStrategy::Zero);
+    EXPECT_EQ(ShredStrategy::Zero, data.shredStrategy());
+
+    // moves keep the strategy
+    SecureUniquePtr<uint8_t[]> moved(std::move(data));
+    EXPECT_EQ(ShredStrategy::Zero, moved.shredStrategy());
+    EXPECT_EQ(MemoryShredder::DEFAULT_STRATEGY, data.shredStrategy());
+
+#ifdef SECURE_MEMORY_POOL
+    // pool blocks are shredded with the array's strategy. The first bytes link the cached block.
+    SecurePool::trim();
+    uint8_t *raw = moved().get();
+    memset(raw, 0x11, 100);
+    moved.dirty(50);
+    moved = SecureUniquePtr<uint8_t[]>();
+
+    // only dirty bytes are shredded
+    SecureUniquePtr<uint8_t[]> reused(100);
+    ASSERT_EQ(raw, reused().get());
+    EXPECT_EQ(50u - sizeof(void *), countBytes(raw + sizeof(void *), 50 - sizeof(void *), 0));
+    EXPECT_EQ(50u, countBytes(raw + 50, 50, 0x11));
+#endif
+}
+
+#endif
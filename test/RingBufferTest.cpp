@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <secure_memory/RingBuffer.h>
+#include <secure_memory/BufferRange.h>
+#include "RingBufferTest.h"
+#include "custom_assert.h"
+
+TEST_F(RingBufferTest, WriteRead) {
+    RingBuffer r(8);
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(8u, r.capacity());
+    EXPECT_EQ(8u, r.available());
+
+    EXPECT_EQ(6u, r.write("abcdef", 6));
+    EXPECT_EQ(6u, r.size());
+    EXPECT_EQ(2u, r.available());
+
+    // write is limited by free space
+    EXPECT_EQ(2u, r.write("ghij", 4));
+    EXPECT_TRUE(r.full());
+    EXPECT_EQ(0u, r.write("x", 1));
+
+    char out[8];
+    EXPECT_EQ(3u, r.peek(out, 3, 2));
+    EXPECT_ARRAY_EQ(const char, "cde", out, 3);
+    EXPECT_EQ(8u, r.size());
+
+    EXPECT_EQ(4u, r.read(out, 4));
+    EXPECT_ARRAY_EQ(const char, "abcd", out, 4);
+    EXPECT_EQ(4u, r.size());
+
+    // read is limited by readable bytes
+    EXPECT_EQ(4u, r.read(out, 8));
+    EXPECT_ARRAY_EQ(const char, "efgh", out, 4);
+    EXPECT_TRUE(r.empty());
+}
+
+TEST_F(RingBufferTest, WrapAround) {
+    RingBuffer r(8);
+    char out[8];
+
+    r.write("abcdef", 6);
+    r.consume(4);
+
+    // "ef" at 4..5, wraps after two more bytes
+    EXPECT_EQ(6u, r.write("012345", 6));
+    EXPECT_TRUE(r.full());
+
+    auto readable = r.readable();
+    ASSERT_EQ(4u, readable.first.size());
+    ASSERT_EQ(4u, readable.second.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "ef01", readable.first.data(), 4);
+    EXPECT_ARRAY_EQ(const uint8_t, "2345", readable.second.data(), 4);
+
+    // peek across the wrap
+    EXPECT_EQ(4u, r.peek(out, 4, 2));
+    EXPECT_ARRAY_EQ(const char, "0123", out, 4);
+    EXPECT_EQ(2u, r.peek(out, 4, 6));
+    EXPECT_ARRAY_EQ(const char, "45", out, 2);
+
+    Buffer b;
+    EXPECT_EQ(7u, r.read(b, 7));
+    EXPECT_EQ(7u, b.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "ef01234", b.const_data(), 7);
+    EXPECT_EQ(1u, r.size());
+}
+
+TEST_F(RingBufferTest, WritableCommit) {
+    RingBuffer r(8);
+
+    auto writable = r.writable();
+    EXPECT_EQ(8u, writable.size());
+    EXPECT_TRUE(writable.second.empty());
+
+    memcpy(writable.first.data(), "abcdef", 6);
+    r.commit(6);
+    r.consume(3);
+
+    // free space is split at the end of the allocation
+    writable = r.writable();
+    ASSERT_EQ(2u, writable.first.size());
+    ASSERT_EQ(3u, writable.second.size());
+    memcpy(writable.first.data(), "gh", 2);
+    memcpy(writable.second.data(), "ijk", 3);
+
+    // commit is limited by free space
+    r.commit(10);
+    EXPECT_TRUE(r.full());
+    EXPECT_TRUE(r.writable().first.empty());
+    EXPECT_TRUE(r.writable().second.empty());
+
+    char out[8];
+    EXPECT_EQ(8u, r.read(out, 8));
+    EXPECT_ARRAY_EQ(const char, "defghijk", out, 8);
+
+    // an empty RingBuffer starts over at the beginning
+    EXPECT_EQ(8u, r.writable().first.size());
+}
+
+TEST_F(RingBufferTest, Streaming) {
+    RingBuffer r(7);
+    Buffer in, out;
+    for (uint32_t i = 0; i < 1000; i++)
+        in.appendValue(static_cast<uint8_t>(i * 31));
+
+    // odd chunk sizes exercise every wrap position
+    uint32_t written = 0;
+    while (out.size() < in.size()) {
+        written += r.write(in.const_data(written, std::min(in.size() - written, 5u)));
+        r.read(out, 3);
+    }
+
+    EXPECT_EQ(in, out);
+    EXPECT_TRUE(r.empty());
+}
+
+TEST_F(RingBufferTest, Move) {
+    RingBuffer a(8);
+    a.write("abcdef", 6);
+    a.consume(2);
+
+    RingBuffer b(std::move(a));
+    EXPECT_EQ(0u, a.capacity());
+    EXPECT_EQ(0u, a.size());
+    EXPECT_EQ(0u, a.write("abc", 3));
+    EXPECT_EQ(4u, b.size());
+
+    RingBuffer c(4);
+    c = std::move(b);
+    EXPECT_EQ(0u, b.capacity());
+    EXPECT_EQ(8u, c.capacity());
+
+    char out[4];
+    EXPECT_EQ(4u, c.read(out, 4));
+    EXPECT_ARRAY_EQ(const char, "cdef", out, 4);
+}
+
+TEST_F(RingBufferTest, Clear) {
+    RingBuffer r(8);
+    r.write("abcdef", 6);
+    r.consume(2);
+
+    r.clear(true);
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(8u, r.writable().first.size());
+}
+
+TEST_F(RingBufferTest, ShredStrategy) {
+    RingBuffer r(8);
+    EXPECT_EQ(MemoryShredder::DEFAULT_STRATEGY, r.shredStrategy());
+    r.shredStrategy(ShredStrategy::Pattern);
+    r.write("abcdef", 6);
+
+#ifdef SECURE_MEMORY_UNIQUE_PTR_SHRED
+    // clearing uses the strategy of the allocation
+    const uint8_t *raw = r.readable().first.data();
+    r.clear(true);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[0]);
+    EXPECT_EQ(MemoryShredder::PATTERN, raw[7]);
+#endif
+
+    // moves keep the strategy
+    RingBuffer moved(std::move(r));
+    EXPECT_EQ(ShredStrategy::Pattern, moved.shredStrategy());
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include <secure_memory/Buffer.h>
+#include <secure_memory/SecureHeap.h>
+#include "SecureHeapTest.h"
+
+TEST_F(SecureHeapTest, Basic) {
+    SecureHeapStats before = SecureHeap::stats();
+
+    // small blocks are carved out of a locked region
+    void *data = SecureHeap::allocate(100);
+    ASSERT_NE(nullptr, data);
+    memset(data, 0xAB, 100);
+
+    SecureHeapStats stats = SecureHeap::stats();
+    EXPECT_GE(stats.locked, SecureHeap::REGION_SIZE);
+    EXPECT_EQ(before.used + 128, stats.used);
+    EXPECT_EQ(stats.locked - stats.used, stats.free);
+    EXPECT_EQ(before.allocations + 1, stats.allocations);
+
+    // freed blocks are reused
+    SecureHeap::deallocate(data, 100);
+    EXPECT_EQ(before.used, SecureHeap::stats().used);
+    EXPECT_EQ(data, SecureHeap::allocate(120));
+    SecureHeap::deallocate(data, 120);
+
+    // many blocks fit into one region
+    size_t mappings = SecureHeap::stats().mappings;
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100; i++)
+        blocks.push_back(SecureHeap::allocate(32));
+    EXPECT_LE(SecureHeap::stats().mappings, mappings + 1);
+    for (void *block : blocks)
+        SecureHeap::deallocate(block, 32);
+
+    EXPECT_EQ(before.used, SecureHeap::stats().used);
+}
+
+TEST_F(SecureHeapTest, Alignment) {
+    for (size_t alignment : {size_t(1), size_t(16), size_t(64), size_t(4096)}) {
+        void *data = SecureHeap::allocate(24, alignment);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data) % alignment);
+        SecureHeap::deallocate(data, 24, alignment);
+    }
+
+    EXPECT_THROW(SecureHeap::allocate(16, 1024 * 1024), std::bad_alloc);
+}
+
+TEST_F(SecureHeapTest, Large) {
+    SecureHeapStats before = SecureHeap::stats();
+
+    // large blocks get their own mapping, which is released on free
+    size_t size = SecureHeap::MAX_BLOCK_SIZE * 2;
+    auto *data = static_cast<uint8_t *>(SecureHeap::allocate(size));
+    memset(data, 0xAB, size);
+
+    SecureHeapStats stats = SecureHeap::stats();
+    EXPECT_EQ(before.mappings + 1, stats.mappings);
+    EXPECT_EQ(before.locked + size, stats.locked);
+    EXPECT_EQ(before.used + size, stats.used);
+
+#ifndef _WIN32
+    // guard pages surround the mapping
+    EXPECT_DEATH(data[size] = 1, "");
+    EXPECT_DEATH(data[-1] = 1, "");
+#endif
+
+    SecureHeap::deallocate(data, size);
+    stats = SecureHeap::stats();
+    EXPECT_EQ(before.mappings, stats.mappings);
+    EXPECT_EQ(before.locked, stats.locked);
+}
+
+TEST_F(SecureHeapTest, Resource) {
+    std::pmr::memory_resource *resource = SecureHeap::resource();
+    EXPECT_EQ(resource, SecureHeap::resource());
+    size_t used = SecureHeap::stats().used;
+
+    {
+        SecureUniquePtr<uint8_t[]> ptr(100, resource);
+        EXPECT_EQ(resource, ptr.resource());
+        EXPECT_EQ(used + 128, SecureHeap::stats().used);
+
+        // Buffers keep even small data in locked memory
+        Buffer b(0, resource);
+        b.append("secret", 6);
+        EXPECT_EQ(used + 128 + 16, SecureHeap::stats().used);
+        uint8_t payload[100] = {};
+        b.append(payload, sizeof(payload));
+        b.shrink_to_fit();
+        EXPECT_EQ(used + 128 + 128, SecureHeap::stats().used);
+
+        Buffer moved(std::move(b));
+        EXPECT_EQ(resource, moved.resource());
+        EXPECT_EQ(used + 128 + 128, SecureHeap::stats().used);
+    }
+
+    EXPECT_EQ(used, SecureHeap::stats().used);
+}
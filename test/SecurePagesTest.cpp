@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <secure_memory/SecurePages.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include "SecurePagesTest.h"
+
+TEST_F(SecurePagesTest, Basic) {
+    // pages start zeroed
+    uint64_t allocations = SecurePages::allocations();
+    auto *data = static_cast<uint8_t *>(SecurePages::allocate(10000));
+    EXPECT_EQ(allocations + 1, SecurePages::allocations());
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(0, data[9999]);
+    memset(data, 0xAB, 10000);
+    SecurePages::deallocate(data, 10000);
+    SecurePages::deallocate(nullptr, 10);
+}
+
+TEST_F(SecurePagesTest, Reallocate) {
+    auto *data = static_cast<uint8_t *>(SecurePages::allocate(10000));
+    memset(data, 0xAB, 10000);
+
+    auto *grown = static_cast<uint8_t *>(SecurePages::reallocate(data, 10000, 1000000));
+#ifdef __linux__
+    // contents move with the pages, new pages are zeroed
+    ASSERT_NE(nullptr, grown);
+    EXPECT_EQ(0xAB, grown[0]);
+    EXPECT_EQ(0xAB, grown[9999]);
+    EXPECT_EQ(0, grown[999999]);
+    SecurePages::deallocate(grown, 1000000);
+#else
+    EXPECT_EQ(nullptr, grown);
+    SecurePages::deallocate(data, 10000);
+#endif
+}
+
+TEST_F(SecurePagesTest, Resource) {
+    std::pmr::memory_resource *resource = SecurePages::resource();
+    EXPECT_EQ(resource, SecurePages::resource());
+
+    SecureUniquePtr<uint8_t[]> ptr(100, resource);
+    EXPECT_EQ(resource, ptr.resource());
+    memset(ptr().get(), 0xAB, 100);
+}
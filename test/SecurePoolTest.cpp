@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <secure_memory/SecurePool.h>
+#include <secure_memory/SecureUniquePtr.h>
+#include "SecurePoolTest.h"
+
+TEST_F(SecurePoolTest, Basic) {
+    EXPECT_EQ(nullptr, SecurePool::allocate(0));
+    SecurePool::deallocate(nullptr, 10);
+
+    void *data = SecurePool::allocate(100);
+    ASSERT_NE(nullptr, data);
+    memset(data, 0xAB, 100);
+    SecurePool::deallocate(data, 100);
+
+    // oversize blocks work, but are not cached
+    data = SecurePool::allocate(SecurePool::MAX_BLOCK_SIZE + 1);
+    ASSERT_NE(nullptr, data);
+    memset(data, 0xAB, SecurePool::MAX_BLOCK_SIZE + 1);
+    SecurePool::deallocate(data, SecurePool::MAX_BLOCK_SIZE + 1);
+}
+
+TEST_F(SecurePoolTest, Resource) {
+    std::pmr::memory_resource *resource = SecurePool::resource();
+    EXPECT_EQ(resource, SecurePool::resource());
+    EXPECT_TRUE(resource->is_equal(*SecurePool::resource()));
+
+    void *data = resource->allocate(100);
+    memset(data, 0xAB, 100);
+    resource->deallocate(data, 100);
+
+    // over-aligned blocks work as well
+    data = resource->allocate(100, 256);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data) % 256);
+    resource->deallocate(data, 100, 256);
+
+    // for trivial types the resource is equivalent to the default allocation
+    SecureUniquePtr<uint8_t[]> ptr(100, resource);
+    EXPECT_EQ(nullptr, ptr.resource());
+    // the internal pointer cannot be replaced by memory the deleter does not own
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(ptr())>>);
+
+    // std::pmr containers work on top of the pool
+    std::pmr::vector<uint32_t> vector(resource);
+    for (uint32_t i = 0; i < 1000; i++)
+        vector.push_back(i);
+    EXPECT_EQ(999u, vector.back());
+}
+
+#ifdef SECURE_MEMORY_POOL
+
+TEST_F(SecurePoolTest, Reuse) {
+    SecurePool::trim();
+    SecurePool::resetStats();
+
+    void *a = SecurePool::allocate(100);
+    EXPECT_EQ(1u, SecurePool::stats().misses);
+    SecurePool::deallocate(a, 100);
+    EXPECT_EQ(128u, SecurePool::stats().retained);
+
+    // same size class
+    void *b = SecurePool::allocate(128);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(1u, SecurePool::stats().hits);
+    EXPECT_EQ(0u, SecurePool::stats().retained);
+
+    // other size class
+    void *c = SecurePool::allocate(129);
+    EXPECT_EQ(2u, SecurePool::stats().misses);
+
+    SecurePool::deallocate(b, 128);
+    SecurePool::deallocate(c, 129);
+    EXPECT_EQ(128u + 256u, SecurePool::stats().retained);
+
+    SecurePool::trim();
+    EXPECT_EQ(0u, SecurePool::stats().retained);
+    EXPECT_EQ(1u, SecurePool::stats().hits);
+    EXPECT_EQ(0u, SecurePool::stats().releases);
+}
+
+TEST_F(SecurePoolTest, Limits) {
+    SecurePool::trim();
+    SecurePool::resetStats();
+    size_t max = SecurePool::maxRetained();
+
+    // oversize blocks are released
+    SecurePool::deallocate(SecurePool::allocate(SecurePool::MAX_BLOCK_SIZE + 1), SecurePool::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(1u, SecurePool::stats().releases);
+    EXPECT_EQ(0u, SecurePool::stats().retained);
+
+    // blocks exceeding the limit are released
+    SecurePool::maxRetained(64);
+    void *a = SecurePool::allocate(64), *b = SecurePool::allocate(64);
+    SecurePool::deallocate(a, 64);
+    SecurePool::deallocate(b, 64);
+    EXPECT_EQ(64u, SecurePool::stats().retained);
+    EXPECT_EQ(2u, SecurePool::stats().releases);
+
+    SecurePool::maxRetained(0);
+    SecurePool::deallocate(SecurePool::allocate(16), 16);
+    EXPECT_EQ(3u, SecurePool::stats().releases);
+
+    SecurePool::maxRetained(max);
+    SecurePool::trim();
+}
+
+TEST_F(SecurePoolTest, SecureUniquePtr) {
+    SecurePool::trim();
+    SecurePool::resetStats();
+
+    const uint8_t *first;
+    {
+        SecureUniquePtr<uint8_t[]> data(1000);
+        EXPECT_EQ(1000u, data.size());
+        first = data().get();
+    }
+    EXPECT_EQ(1024u, SecurePool::stats().retained);
+
+    // moved-from pointers do not release anything
+    SecureUniquePtr<uint8_t[]> data(1000);
+    EXPECT_EQ(first, data().get());
+    SecureUniquePtr<uint8_t[]> moved(std::move(data));
+    EXPECT_EQ(0u, data.size());
+    EXPECT_EQ(nullptr, data().get());
+    EXPECT_EQ(1000u, moved.size());
+
+    // assignment releases the previous array
+    moved = SecureUniquePtr<uint8_t[]>(10);
+    EXPECT_EQ(1024u, SecurePool::stats().retained);
+    EXPECT_EQ(1u, SecurePool::stats().hits);
+    EXPECT_EQ(2u, SecurePool::stats().misses);
+
+    SecurePool::trim();
+}
+
+TEST_F(SecurePoolTest, Threads) {
+    SecurePool::trim();
+    SecurePool::resetStats();
+    SecurePool::deallocate(SecurePool::allocate(32), 32);
+
+    // each thread has its own cache
+    std::thread([] {
+        EXPECT_EQ(0u, SecurePool::stats().retained);
+        void *data = SecurePool::allocate(32);
+        EXPECT_EQ(0u, SecurePool::stats().hits);
+        SecurePool::deallocate(data, 32);
+        EXPECT_EQ(32u, SecurePool::stats().retained);
+    }).join();
+
+    EXPECT_EQ(32u, SecurePool::stats().retained);
+    EXPECT_EQ(0u, SecurePool::stats().hits);
+    SecurePool::trim();
+}
+
+TEST_F(SecurePoolTest, ThreadExit) {
+    SecurePool::trim();
+    SecurePool::resetStats();
+
+    // allocates once the thread's cache is already destroyed
+    struct LateAllocation {
+        ~LateAllocation() {
+            *data = SecurePool::allocate(100);
+        }
+        void **data;
+    };
+
+    void *data = nullptr;
+    std::thread([&data] {
+        // constructed before the cache, thus destroyed after it
+        static thread_local LateAllocation late {&data};
+        SecurePool::deallocate(SecurePool::allocate(32), 32);
+        (void) late;
+    }).join();
+    ASSERT_NE(nullptr, data);
+
+    // freed on another thread, the block is cached and reused for its whole size class
+    SecurePool::deallocate(data, 100);
+    EXPECT_EQ(128u, SecurePool::stats().retained);
+    void *reused = SecurePool::allocate(128);
+    EXPECT_EQ(data, reused);
+    memset(reused, 0xAB, 128);
+    SecurePool::deallocate(reused, 128);
+
+    SecurePool::trim();
+}
+
+#endif
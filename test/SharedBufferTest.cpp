@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <thread>
+#include <vector>
+
+#include <secure_memory/SharedBuffer.h>
+#include <secure_memory/BaseN.h>
+#include "SharedBufferTest.h"
+#include "custom_assert.h"
+
+TEST_F(SharedBufferTest, Basic) {
+    SharedBuffer empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0, empty.useCount());
+    EXPECT_EQ(nullptr, empty.const_data());
+    EXPECT_EQ(0u, BufferRangeConst(empty).size());
+    EXPECT_TRUE(empty.toBuffer().empty());
+
+    // heap storage is taken over
+    Buffer buffer(Buffer::INLINE_SIZE + 10);
+    buffer.padd(Buffer::INLINE_SIZE + 10, 'x');
+    const uint8_t *raw = buffer.const_data();
+
+    SharedBuffer a(std::move(buffer));
+    EXPECT_EQ(raw, a.const_data());
+    EXPECT_EQ(Buffer::INLINE_SIZE + 10, a.size());
+    EXPECT_EQ(1, a.useCount());
+
+    // copies share the data
+    SharedBuffer b(a);
+    EXPECT_EQ(raw, b.const_data());
+    EXPECT_EQ(2, a.useCount());
+    EXPECT_EQ(a, b);
+
+    SharedBuffer c(Buffer("abc"));
+    EXPECT_NE(a, c);
+    EXPECT_EQ(SharedBuffer(Buffer("abc")), c);
+    EXPECT_EQ(SharedBuffer(Buffer("abc").const_data(0, 3)), c);
+}
+
+TEST_F(SharedBufferTest, Slice) {
+    SharedBuffer message(Buffer("header:payload"));
+
+    SharedBuffer payload = message.slice(7);
+    EXPECT_EQ(2, message.useCount());
+    EXPECT_EQ(7u, payload.size());
+    EXPECT_EQ(message.const_data(7), payload.const_data());
+    EXPECT_ARRAY_EQ(const uint8_t, "payload", payload.const_data(), 7);
+
+    // slices of slices, limited to the slice
+    SharedBuffer load = payload.slice(3, 100);
+    EXPECT_ARRAY_EQ(const uint8_t, "load", load.const_data(), 4);
+    EXPECT_EQ(0u, payload.slice(100).size());
+    EXPECT_EQ('d', *load.const_data<char>(3));
+    EXPECT_EQ(load.const_data(4), load.const_data(100));
+
+    // slices keep the data alive
+    message = SharedBuffer();
+    EXPECT_EQ(2, payload.useCount());
+    EXPECT_ARRAY_EQ(const uint8_t, "payload", payload.const_data(), 7);
+
+    // ranges work with existing readers
+    BufferRangeConst range = load;
+    EXPECT_EQ(4u, range.size());
+    EXPECT_ARRAY_EQ(const uint8_t, "load", range.const_data(), 4);
+    EXPECT_ARRAY_EQ(const uint8_t, "oa", payload.const_data(4, 2).const_data(), 2);
+    EXPECT_EQ(String("bG9hZA=="), BaseN::Base64::encode(load));
+
+    BufferView view = load.view();
+    EXPECT_EQ(4u, view.size());
+    EXPECT_EQ(load.const_data(), view.data());
+}
+
+TEST_F(SharedBufferTest, ToBuffer) {
+    Buffer buffer(Buffer::INLINE_SIZE + 10);
+    buffer.append("header:payload", 14);
+    const uint8_t *raw = buffer.const_data();
+
+    SharedBuffer message(std::move(buffer));
+    SharedBuffer payload = message.slice(7);
+
+    // shared data is copied
+    Buffer copy = payload.toBuffer();
+    EXPECT_EQ(Buffer("payload"), copy);
+    Buffer moved = SharedBuffer(payload).toBuffer();
+    EXPECT_EQ(Buffer("payload"), moved);
+    EXPECT_NE(raw + 7, moved.const_data());
+    EXPECT_EQ(2, payload.useCount());
+
+    // the last reference takes the Buffer over
+    message = SharedBuffer();
+    Buffer taken = std::move(payload).toBuffer();
+    EXPECT_EQ(Buffer("payload"), taken);
+    EXPECT_EQ(raw + 7, taken.const_data());
+    EXPECT_TRUE(payload.empty());
+    EXPECT_EQ(0, payload.useCount());
+
+    // a trailing slice drops the tail
+    Buffer head = SharedBuffer(Buffer("header:payload")).slice(0, 6).toBuffer();
+    EXPECT_EQ(Buffer("header"), head);
+    head.append("!", 1);
+    EXPECT_EQ(Buffer("header!"), head);
+}
+
+TEST_F(SharedBufferTest, Threads) {
+    SharedBuffer message(Buffer("fan out to many peers"));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++)
+        threads.emplace_back([copy = message] {
+            for (int j = 0; j < 1000; j++) {
+                SharedBuffer slice = copy.slice(4, 3);
+                EXPECT_ARRAY_EQ(const uint8_t, "out", slice.const_data(), 3);
+            }
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(1, message.useCount());
+}
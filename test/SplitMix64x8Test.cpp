@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 The ViaDuck Project
+ *
+ * This file is part of SecureMemory.
+ *
+ * SecureMemory is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SecureMemory is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <secure_memory/SplitMix64.h>
+#include <secure_memory/SplitMix64x8.h>
+#include "SplitMix64x8Test.h"
+
+TEST_F(SplitMix64x8Test, MatchesSplitMix64) {
+    // lanes are seeded with consecutive outputs of SplitMix64(seed)
+    SplitMix64 seeder(42);
+    SplitMix64 lanes[SplitMix64x8::LANES];
+    for (SplitMix64 &lane : lanes)
+        lane = SplitMix64(seeder.next());
+
+    // word i of each block is the next output of lane i, the partial block consumes a whole one
+    uint64_t expected[5 * SplitMix64x8::LANES];
+    for (size_t i = 0; i < 5 * SplitMix64x8::LANES; i++)
+        expected[i] = lanes[i % SplitMix64x8::LANES].next();
+
+    SplitMix64Isa original = SplitMix64x8::isa();
+    for (SplitMix64Isa isa : {SplitMix64Isa::Scalar, SplitMix64Isa::AVX2, SplitMix64Isa::AVX512}) {
+        if (isa > SplitMix64x8::supportedIsa())
+            continue;
+        SplitMix64x8::isa(isa);
+        EXPECT_EQ(isa, SplitMix64x8::isa());
+
+        // unaligned, split into multiple calls
+        SplitMix64x8 rng(42);
+        uint8_t data[sizeof(expected) + 1];
+        rng.nextBytes(data + 1, 2 * SplitMix64x8::BLOCK_SIZE);
+        rng.nextBytes(data + 1 + 2 * SplitMix64x8::BLOCK_SIZE, SplitMix64x8::BLOCK_SIZE + 5);
+        rng.nextBytes(data + 1 + 4 * SplitMix64x8::BLOCK_SIZE, SplitMix64x8::BLOCK_SIZE);
+        EXPECT_EQ(0, memcmp(expected, data + 1, 3 * SplitMix64x8::BLOCK_SIZE + 5));
+        EXPECT_EQ(0, memcmp(expected + 4 * SplitMix64x8::LANES, data + 1 + 4 * SplitMix64x8::BLOCK_SIZE,
+                            SplitMix64x8::BLOCK_SIZE));
+        rng.nextBytes(nullptr, 0);
+    }
+
+    // limited to the supported instruction set
+    SplitMix64x8::isa(SplitMix64Isa::AVX512);
+    EXPECT_EQ(SplitMix64x8::supportedIsa(), SplitMix64x8::isa());
+    SplitMix64x8::isa(original);
+}
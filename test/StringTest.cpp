@@ -17,6 +17,8 @@
  * along with SecureMemory.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <memory_resource>
+
 #include "StringTest.h"
 #include "secure_memory/String.h"
 #include "custom_assert.h"
@@ -621,6 +623,19 @@ TEST(StringTest, istreamTest) {
         ASSERT_EQ(0, static_cast<int32_t>(s.size()));
         EXPECT_ARRAY_EQ(const char, "", s.const_data(), static_cast<int32_t>(s.size()) + 1);       // compare the 0-terminator, too!
     }
+
+    {
+        // lines are appended to existing contents
+        String s("prefix longer than the inline storage ");
+
+        char buffer[] = "abc\ndef";
+        membuf sbuf(buffer, buffer + sizeof(buffer));
+        std::istream in(&sbuf);
+
+        in >> s;        // stream it!
+
+        EXPECT_EQ(String("prefix longer than the inline storage abc"), s);
+    }
 }
 
 TEST(StringTest, ostreamTest) {
@@ -830,3 +845,38 @@ TEST(StringTest, hashOp) {
         ASSERT_EQ(hashTest, hashTest2);
     }
 }
+
+TEST(StringTest, memoryResource) {
+    uint8_t arena[2048];
+    std::pmr::monotonic_buffer_resource resource(arena, sizeof(arena), std::pmr::null_memory_resource());
+
+    String s("a string too long for the inline storage", &resource);
+    EXPECT_EQ(&resource, s.resource());
+    EXPECT_EQ(String("a string too long for the inline storage"), s);
+    EXPECT_GE(s.const_data(), arena);
+    EXPECT_LT(s.const_data(), arena + sizeof(arena));
+
+    // c-strings are allocated from the same resource
+    const char *c = s.c_str();
+    EXPECT_STREQ("a string too long for the inline storage", c);
+    EXPECT_GE(reinterpret_cast<const uint8_t *>(c), arena);
+    EXPECT_LT(reinterpret_cast<const uint8_t *>(c), arena + sizeof(arena));
+
+    // inherited Buffer constructors accept resources as well
+    String t(s, &resource);
+    EXPECT_EQ(&resource, t.resource());
+    EXPECT_EQ(s, t);
+}
+
+TEST(StringTest, copySecureHeap) {
+    // copies of locked Strings stay in locked memory
+    String s("secret", SecureHeap::resource());
+    String copy(s);
+    EXPECT_EQ(SecureHeap::resource(), copy.resource());
+    EXPECT_EQ(s, copy);
+
+    const Buffer &buffer = s;
+    String fromBuffer(buffer);
+    EXPECT_EQ(SecureHeap::resource(), fromBuffer.resource());
+    EXPECT_EQ(s, fromBuffer);
+}